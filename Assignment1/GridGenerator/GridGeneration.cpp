@@ -0,0 +1,226 @@
+#define _CRT_SECURE_NO_WARNINGS //  Disable unsafe warnings, to enable use of printf within VS2017
+
+#include <algorithm>
+#include <cstdio>
+
+#include "GridGenerator.h"
+
+// The grid generation is shared with the benchmark, so the grids it generates are the ones GridGenerator writes out
+
+unsigned int RandomInt(std::mt19937 *rng, unsigned int range)
+{
+    // A number from 0 to range - 1
+    return (unsigned int)((*rng)() % range);
+}
+
+double RandomUnit(std::mt19937 *rng)
+{
+    // A number from 0 up to (but not including) 1
+    return (*rng)() / 4294967296.0;
+}
+
+void SetDefaultOptions(generatorOptions_t *options)
+{
+    options->gridSizeX = DEFAULT_GRID_SIZE;
+    options->gridSizeY = DEFAULT_GRID_SIZE;
+    options->gridSizeZ = 1;
+    options->density = DEFAULT_DENSITY;
+    options->pattern = PATTERN_RANDOM;
+    options->numNets = 0;
+    options->minPins = 2;
+    options->maxPins = 4;
+    options->pinDistribution = PINS_UNIFORM;
+    options->netSpan = DEFAULT_NET_SPAN;
+    options->seed = 1;
+}
+
+void GenerateGrid(generatorOptions_t *options, generatedGrid_t *grid)
+{
+    std::mt19937 rng;
+
+    rng.seed(options->seed);
+
+    // By default, scale the number of nets with the grid like the benchmarks do
+    if(options->numNets == 0)
+    {
+        options->numNets = std::max((options->gridSizeX * options->gridSizeY) / DEFAULT_CELLS_PER_NET, 1u);
+    }
+
+    // Lay out the obstructions, then find room for the nets between them
+    grid->blocked.assign((size_t)options->gridSizeX * options->gridSizeY, false);
+    grid->used.assign((size_t)options->gridSizeX * options->gridSizeY, false);
+    grid->nets.clear();
+    grid->numObstructions = 0;
+    switch(options->pattern)
+    {
+        case PATTERN_ROWS:
+            GenerateRows(options, grid, &rng);
+            break;
+        case PATTERN_MACROS:
+            GenerateMacros(options, grid, &rng);
+            break;
+        default:
+            GenerateRandom(options, grid, &rng);
+            break;
+    }
+    GenerateNets(options, grid, &rng);
+}
+
+void BlockRect(generatorOptions_t *options, generatedGrid_t *grid, unsigned int x0, unsigned int y0, unsigned int width, unsigned int height)
+{
+    unsigned int x, y;
+    size_t index;
+
+    // Obstruct the rectangle, clipped to the grid
+    for(y = y0; y < std::min(y0 + height, options->gridSizeY); y++)
+    {
+        for(x = x0; x < std::min(x0 + width, options->gridSizeX); x++)
+        {
+            index = (size_t)y * options->gridSizeX + x;
+            if(!grid->blocked[index])
+            {
+                grid->blocked[index] = true;
+                grid->numObstructions++;
+            }
+        }
+    }
+}
+
+void GenerateRandom(generatorOptions_t *options, generatedGrid_t *grid, std::mt19937 *rng)
+{
+    size_t i;
+
+    // Every cell on its own
+    for(i = 0; i < grid->blocked.size(); i++)
+    {
+        if(RandomUnit(rng) < options->density)
+        {
+            grid->blocked[i] = true;
+            grid->numObstructions++;
+        }
+    }
+}
+
+void GenerateRows(generatorOptions_t *options, generatedGrid_t *grid, std::mt19937 *rng)
+{
+    unsigned int x, y, period, nextGap;
+
+    if(options->density <= 0)
+    {
+        return;
+    }
+
+    // Rows of cells ROW_HEIGHT high, spaced out so they cover about the density we were asked for
+    period = std::max((unsigned int)(ROW_HEIGHT / options->density + 0.5), (unsigned int)ROW_HEIGHT + 1);
+    for(y = 1 + RandomInt(rng, period - ROW_HEIGHT); y + ROW_HEIGHT <= options->gridSizeY; y += period)
+    {
+        // Leave a feedthrough every so often so nets can cross the row
+        nextGap = ROW_FEEDTHROUGH_MIN_GAP + RandomInt(rng, ROW_FEEDTHROUGH_MAX_GAP - ROW_FEEDTHROUGH_MIN_GAP + 1);
+        for(x = 0; x < options->gridSizeX; x++)
+        {
+            if(x == nextGap)
+            {
+                nextGap += 1 + ROW_FEEDTHROUGH_MIN_GAP + RandomInt(rng, ROW_FEEDTHROUGH_MAX_GAP - ROW_FEEDTHROUGH_MIN_GAP + 1);
+                continue;
+            }
+            BlockRect(options, grid, x, y, 1, ROW_HEIGHT);
+        }
+    }
+}
+
+void GenerateMacros(generatorOptions_t *options, generatedGrid_t *grid, std::mt19937 *rng)
+{
+    unsigned int i, maxSize, width, height;
+    unsigned long long target;
+
+    // Drop blocks of random sizes until enough of the grid is covered, overlapping blocks make bigger odd shaped ones
+    target = (unsigned long long)(options->density * options->gridSizeX * options->gridSizeY);
+    maxSize = std::max(std::min(options->gridSizeX, options->gridSizeY) / MACRO_SIZE_DIVISOR, (unsigned int)MACRO_MIN_SIZE);
+    for(i = 0; i < MACRO_PLACEMENT_ATTEMPTS && grid->numObstructions < target; i++)
+    {
+        width = MACRO_MIN_SIZE + RandomInt(rng, maxSize - MACRO_MIN_SIZE + 1);
+        height = MACRO_MIN_SIZE + RandomInt(rng, maxSize - MACRO_MIN_SIZE + 1);
+        BlockRect(options, grid, RandomInt(rng, options->gridSizeX), RandomInt(rng, options->gridSizeY), width, height);
+    }
+}
+
+unsigned int PickPinCount(generatorOptions_t *options, std::mt19937 *rng)
+{
+    unsigned int pins;
+
+    if(options->pinDistribution == PINS_GEOMETRIC)
+    {
+        // Keep adding pins on a coin flip
+        pins = options->minPins;
+        while(pins < options->maxPins && RandomUnit(rng) < 0.5)
+        {
+            pins++;
+        }
+        return pins;
+    }
+    return options->minPins + RandomInt(rng, options->maxPins - options->minPins + 1);
+}
+
+void GenerateNets(generatorOptions_t *options, generatedGrid_t *grid, std::mt19937 *rng)
+{
+    unsigned int i, j, attempt, pinAttempt, numPins, span, anchorX, anchorY, x, y;
+    unsigned int droppedNets, shrunkNets;
+    size_t index;
+    std::vector<unsigned int> pins;
+
+    span = std::min(options->netSpan, std::min(options->gridSizeX, options->gridSizeY));
+    droppedNets = 0;
+    shrunkNets = 0;
+    for(i = 0; i < options->numNets; i++)
+    {
+        numPins = PickPinCount(options, rng);
+        for(attempt = 0; attempt < NET_PLACEMENT_ATTEMPTS; attempt++)
+        {
+            // Keep a net's pins close together, like a net between neighbouring cells
+            anchorX = RandomInt(rng, options->gridSizeX - span + 1);
+            anchorY = RandomInt(rng, options->gridSizeY - span + 1);
+            pins.clear();
+            for(j = 0; j < numPins; j++)
+            {
+                for(pinAttempt = 0; pinAttempt < PIN_PLACEMENT_ATTEMPTS; pinAttempt++)
+                {
+                    x = anchorX + RandomInt(rng, span);
+                    y = anchorY + RandomInt(rng, span);
+                    index = (size_t)y * options->gridSizeX + x;
+                    if(!grid->blocked[index] && !grid->used[index])
+                    {
+                        grid->used[index] = true;
+                        pins.push_back((unsigned int)index);
+                        break;
+                    }
+                }
+            }
+            if(pins.size() >= 2)
+            {
+                break;
+            }
+            // Not even two pins, give back the one we got and try somewhere else
+            for(j = 0; j < pins.size(); j++)
+            {
+                grid->used[pins[j]] = false;
+            }
+            pins.clear();
+        }
+
+        if(pins.empty())
+        {
+            droppedNets++;
+            continue;
+        }
+        if(pins.size() < numPins)
+        {
+            shrunkNets++;
+        }
+        grid->nets.push_back(pins);
+    }
+
+    if(droppedNets > 0 || shrunkNets > 0)
+    {
+        printf("Couldn't find room for %d net(s), %d net(s) got fewer pins than picked\n", droppedNets, shrunkNets);
+    }
+}
@@ -0,0 +1,257 @@
+#define _CRT_SECURE_NO_WARNINGS //  Disable unsafe warnings, to enable use of fopen within VS2017
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#include "GridGenerator.h"
+
+int main(int argc, char **argv)
+{
+    generatorOptions_t options;
+    generatedGrid_t grid;
+
+    if(argc < 2 || !ParseOptions(argc, argv, &options))
+    {
+        PrintUsage();
+        return -1;
+    }
+    GenerateGrid(&options, &grid);
+
+    printf("Grid size is %d x %d with %d layer(s)\n", options.gridSizeX, options.gridSizeY, options.gridSizeZ);
+    printf("%llu obstructed cells in total (%.1f%%)\n", grid.numObstructions, 100.0 * grid.numObstructions / ((double)options.gridSizeX * options.gridSizeY));
+    printf("%d nets in total\n", (int)grid.nets.size());
+
+    return WriteGrid(argv[1], &options, &grid) ? 0 : -1;
+}
+
+bool ParseOptions(int argc, char **argv, generatorOptions_t *options)
+{
+    int i;
+
+    SetDefaultOptions(options);
+
+    // Check for optional flags after the filename
+    for(i = 2; i < argc; i++)
+    {
+        // Grid size
+        if(strcmp(argv[i], "-x") == 0 && i + 1 < argc)
+        {
+            options->gridSizeX = atoi(argv[++i]);
+        }
+        else if(strcmp(argv[i], "-y") == 0 && i + 1 < argc)
+        {
+            options->gridSizeY = atoi(argv[++i]);
+        }
+        // Number of routing layers
+        else if(strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+        {
+            options->gridSizeZ = atoi(argv[++i]);
+        }
+        // Fraction of the cells to obstruct
+        else if(strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            options->density = atof(argv[++i]);
+        }
+        // Obstruction pattern
+        else if(strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+        {
+            i++;
+            if(strcmp(argv[i], "random") == 0)
+            {
+                options->pattern = PATTERN_RANDOM;
+            }
+            else if(strcmp(argv[i], "rows") == 0)
+            {
+                options->pattern = PATTERN_ROWS;
+            }
+            else if(strcmp(argv[i], "macros") == 0)
+            {
+                options->pattern = PATTERN_MACROS;
+            }
+            else
+            {
+                printf("ERROR, unknown pattern %s!\n", argv[i]);
+                return false;
+            }
+        }
+        // Number of nets
+        else if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            options->numNets = atoi(argv[++i]);
+        }
+        // Least and most pins of a net
+        else if(strcmp(argv[i], "-k") == 0 && i + 2 < argc)
+        {
+            options->minPins = atoi(argv[++i]);
+            options->maxPins = atoi(argv[++i]);
+        }
+        // Mostly small nets instead of uniformly picked pin counts
+        else if(strcmp(argv[i], "-g") == 0)
+        {
+            options->pinDistribution = PINS_GEOMETRIC;
+        }
+        // Window a net's pins are picked in
+        else if(strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+        {
+            options->netSpan = atoi(argv[++i]);
+        }
+        // Random seed
+        else if(strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            options->seed = (unsigned int)strtoul(argv[++i], NULL, 10);
+        }
+        else
+        {
+            printf("ERROR, unknown option %s!\n", argv[i]);
+            return false;
+        }
+    }
+
+    // Sanity checks
+    if(options->gridSizeX < 2 || options->gridSizeY < 2 || options->gridSizeX > MAXIMUM_GRID_SIZE || options->gridSizeY > MAXIMUM_GRID_SIZE)
+    {
+        printf("ERROR, the grid size must be between 2 and %d!\n", MAXIMUM_GRID_SIZE);
+        return false;
+    }
+    if(options->gridSizeZ < 1)
+    {
+        printf("ERROR, there must be at least one layer!\n");
+        return false;
+    }
+    if(options->density < 0 || options->density >= 1)
+    {
+        printf("ERROR, the density must be at least 0 and less than 1!\n");
+        return false;
+    }
+    if(options->minPins < 2 || options->maxPins < options->minPins)
+    {
+        printf("ERROR, nets need at least 2 pins, and no more than their most!\n");
+        return false;
+    }
+    if(options->netSpan < 2)
+    {
+        printf("ERROR, the net span must be at least 2!\n");
+        return false;
+    }
+    return true;
+}
+
+void PrintUsage(void)
+{
+    printf("Usage: GridGenerator <output.infile> [options]\n");
+    printf("  -x <cells>          grid size in X (default %d, at most %d)\n", DEFAULT_GRID_SIZE, MAXIMUM_GRID_SIZE);
+    printf("  -y <cells>          grid size in Y (default %d, at most %d)\n", DEFAULT_GRID_SIZE, MAXIMUM_GRID_SIZE);
+    printf("  -l <layers>         number of routing layers (default 1)\n");
+    printf("  -d <fraction>       fraction of the cells to obstruct (default %.2f)\n", DEFAULT_DENSITY);
+    printf("  -p <pattern>        random, rows or macros (default random)\n");
+    printf("  -n <nets>           number of nets (default one per %d cells)\n", DEFAULT_CELLS_PER_NET);
+    printf("  -k <min> <max>      least and most pins of a net (default 2 4)\n");
+    printf("  -g                  mostly small nets, every extra pin is half as likely\n");
+    printf("  -w <cells>          width and height of the window a net's pins are picked in (default %d)\n", DEFAULT_NET_SPAN);
+    printf("  -s <seed>           random seed, the same seed always gives the same grid (default 1)\n");
+}
+
+bool WriteGrid(const char *filename, generatorOptions_t *options, generatedGrid_t *grid)
+{
+    FILE *outputFile;
+    std::string buffer;
+    size_t i, j;
+    bool written;
+
+    outputFile = fopen(filename, "wb");
+    if(outputFile == NULL)
+    {
+        printf("ERROR, file %s couldn't be opened for writing!\n", filename);
+        return false;
+    }
+    buffer.reserve(OUTPUT_BUFFER_SIZE + 64);
+    written = true;
+
+    //1. Grid size, with the number of layers only if there's more than one
+    AppendInt(&buffer, options->gridSizeX);
+    buffer += ' ';
+    AppendInt(&buffer, options->gridSizeY);
+    if(options->gridSizeZ > 1)
+    {
+        buffer += ' ';
+        AppendInt(&buffer, options->gridSizeZ);
+    }
+    buffer += '\n';
+
+    //2. Obstructed cells
+    AppendInt(&buffer, grid->numObstructions);
+    buffer += '\n';
+    for(i = 0; written && i < grid->blocked.size(); i++)
+    {
+        if(grid->blocked[i])
+        {
+            AppendInt(&buffer, i % options->gridSizeX);
+            buffer += ' ';
+            AppendInt(&buffer, i / options->gridSizeX);
+            buffer += '\n';
+            written = FlushBuffer(outputFile, &buffer, false);
+        }
+    }
+
+    //3. Nets, their pin count followed by their pins on one line
+    AppendInt(&buffer, grid->nets.size());
+    buffer += '\n';
+    for(i = 0; written && i < grid->nets.size(); i++)
+    {
+        AppendInt(&buffer, grid->nets[i].size());
+        for(j = 0; j < grid->nets[i].size(); j++)
+        {
+            buffer += ' ';
+            AppendInt(&buffer, grid->nets[i][j] % options->gridSizeX);
+            buffer += ' ';
+            AppendInt(&buffer, grid->nets[i][j] / options->gridSizeX);
+        }
+        buffer += '\n';
+        written = FlushBuffer(outputFile, &buffer, false);
+    }
+    written = written && FlushBuffer(outputFile, &buffer, true);
+
+    if(fclose(outputFile) != 0 || !written)
+    {
+        printf("ERROR, couldn't write %s!\n", filename);
+        return false;
+    }
+    printf("Saved grid to %s\n", filename);
+    return true;
+}
+
+void AppendInt(std::string *buffer, unsigned long long value)
+{
+    char digits[24];
+    int numDigits;
+
+    // Much faster than printf for the millions of numbers in big grids
+    numDigits = 0;
+    do
+    {
+        digits[numDigits++] = '0' + (char)(value % 10);
+        value /= 10;
+    } while(value > 0);
+    while(numDigits > 0)
+    {
+        *buffer += digits[--numDigits];
+    }
+}
+
+bool FlushBuffer(FILE *outputFile, std::string *buffer, bool force)
+{
+    bool written;
+
+    // Write out once there's enough to be worth it, or when we're done
+    if(buffer->size() < OUTPUT_BUFFER_SIZE && !force)
+    {
+        return true;
+    }
+    written = fwrite(buffer->data(), 1, buffer->size(), outputFile) == buffer->size();
+    buffer->clear();
+    return written;
+}
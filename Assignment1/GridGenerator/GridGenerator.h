@@ -0,0 +1,91 @@
+#pragma once
+
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+// Constants used in the generator
+#define MAXIMUM_GRID_SIZE           10000   ///< Largest grid size in X or Y we generate
+#define DEFAULT_GRID_SIZE           100     ///< Grid size in X and Y when it isn't given
+#define DEFAULT_DENSITY             0.2     ///< Fraction of the cells obstructed when it isn't given
+#define DEFAULT_NET_SPAN            32      ///< Width and height of the window a net's pins are picked in when it isn't given
+#define DEFAULT_CELLS_PER_NET       400     ///< Cells of the grid for every net when the number of nets isn't given
+#define PIN_PLACEMENT_ATTEMPTS      64      ///< Tries at finding a free cell for each pin before the net makes do with fewer pins
+#define NET_PLACEMENT_ATTEMPTS      16      ///< Tries at finding a spot for a net with at least two pins before it's dropped
+
+// Constants used in the row pattern
+#define ROW_HEIGHT                  3       ///< Height of a row of cells
+#define ROW_FEEDTHROUGH_MIN_GAP     8       ///< Least number of cells between feedthroughs in a row
+#define ROW_FEEDTHROUGH_MAX_GAP     24      ///< Most number of cells between feedthroughs in a row
+
+// Constants used in the macro pattern
+#define MACRO_MIN_SIZE              4       ///< Smallest width or height of a macro
+#define MACRO_SIZE_DIVISOR          8       ///< Largest width or height of a macro is the grid size over this
+#define MACRO_PLACEMENT_ATTEMPTS    100000  ///< Macros tried before giving up on reaching the density
+
+// Constants used when writing the grid
+#define OUTPUT_BUFFER_SIZE          (1 << 20)   ///< Bytes formatted before they're written out
+
+// This enum contains the ways obstructions can be laid out
+typedef enum
+{
+    PATTERN_RANDOM = 0, ///< Every cell is obstructed with the same probability
+    PATTERN_ROWS,       ///< Standard cell rows with routing channels between them and feedthroughs across them
+    PATTERN_MACROS      ///< Rectangular blocks of different sizes
+} obstructionPattern_e;
+
+// This enum contains the ways the number of pins of a net can be picked
+typedef enum
+{
+    PINS_UNIFORM = 0,   ///< Every pin count between the minimum and maximum is as likely
+    PINS_GEOMETRIC      ///< Every extra pin is half as likely, so most nets have few pins like in real designs
+} pinDistribution_e;
+
+// This struct contains the generator's options
+typedef struct
+{
+    unsigned int            gridSizeX;          ///< The grid size in X
+    unsigned int            gridSizeY;          ///< The grid size in Y
+    unsigned int            gridSizeZ;          ///< The number of routing layers (only written out if more than one)
+    double                  density;            ///< The fraction of the cells to obstruct
+    obstructionPattern_e    pattern;            ///< How the obstructions are laid out
+    unsigned int            numNets;            ///< The number of nets
+    unsigned int            minPins;            ///< The least number of pins of a net
+    unsigned int            maxPins;            ///< The most number of pins of a net
+    pinDistribution_e       pinDistribution;    ///< How the number of pins of a net is picked
+    unsigned int            netSpan;            ///< Width and height of the window a net's pins are picked in
+    unsigned int            seed;               ///< Seed for the random number generator, the same seed always gives the same grid
+} generatorOptions_t;
+
+// This struct contains a generated grid
+typedef struct
+{
+    std::vector<bool>                           blocked;            ///< Whether each cell is obstructed, in (y, x) order
+    std::vector<bool>                           used;               ///< Whether each cell is a pin, in (y, x) order
+    std::vector<std::vector<unsigned int>>      nets;               ///< Every net's pins, as cell indices
+    unsigned long long                          numObstructions;    ///< The number of obstructed cells
+} generatedGrid_t;
+
+// Random numbers (done by hand so the same seed gives the same grid with any standard library)
+unsigned int RandomInt(std::mt19937 *rng, unsigned int range);
+double RandomUnit(std::mt19937 *rng);
+
+// Options
+bool ParseOptions(int argc, char **argv, generatorOptions_t *options);
+void PrintUsage(void);
+
+// Generation (shared with the benchmark)
+void SetDefaultOptions(generatorOptions_t *options);
+void GenerateGrid(generatorOptions_t *options, generatedGrid_t *grid);
+void BlockRect(generatorOptions_t *options, generatedGrid_t *grid, unsigned int x0, unsigned int y0, unsigned int width, unsigned int height);
+void GenerateRandom(generatorOptions_t *options, generatedGrid_t *grid, std::mt19937 *rng);
+void GenerateRows(generatorOptions_t *options, generatedGrid_t *grid, std::mt19937 *rng);
+void GenerateMacros(generatorOptions_t *options, generatedGrid_t *grid, std::mt19937 *rng);
+unsigned int PickPinCount(generatorOptions_t *options, std::mt19937 *rng);
+void GenerateNets(generatorOptions_t *options, generatedGrid_t *grid, std::mt19937 *rng);
+
+// Output
+bool WriteGrid(const char *filename, generatorOptions_t *options, generatedGrid_t *grid);
+void AppendInt(std::string *buffer, unsigned long long value);
+bool FlushBuffer(FILE *outputFile, std::string *buffer, bool force);
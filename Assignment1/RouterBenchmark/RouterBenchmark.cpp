@@ -0,0 +1,543 @@
+#define _CRT_SECURE_NO_WARNINGS //  Disable unsafe warnings, to enable use of fopen within VS2017
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include "RouterBenchmark.h"
+
+#ifdef WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+const char *phaseNames[PHASE_NUM] =
+{
+    "parse", "populate", "seek", "expansion", "walkback", "route", "retries"
+};
+
+int main(int argc, char **argv)
+{
+    int i;
+    unsigned int runs, layers, numInputs;
+    std::vector<std::string> inputArguments;
+    std::vector<std::string> inputFilenames;
+    std::vector<unsigned int> generatedSizes;
+    std::vector<const routerEngine_t*> engines;
+    std::vector<benchmarkResult_t> results;
+    gridStruct_t options = gridStruct_t();
+    const char *resultsFilename;
+    bool benchmarked;
+
+    runs = BENCHMARK_DEFAULT_RUNS;
+    layers = 0;
+    resultsFilename = NULL;
+    for(i = 1; i < argc; i++)
+    {
+        // Input files, directories of them and lists of them
+        if(argv[i][0] != '-')
+        {
+            inputArguments.push_back(argv[i]);
+            continue;
+        }
+        // Runs of every input
+        if(strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+        {
+            runs = std::max(atoi(argv[++i]), 1);
+        }
+        // Also benchmark a generated grid this wide and high
+        if(strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+        {
+            generatedSizes.push_back(atoi(argv[++i]));
+        }
+        // Write the results as JSON
+        if(strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            resultsFilename = argv[++i];
+        }
+        // Only benchmark this engine (every engine when none are given)
+        if(strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+        {
+            engines.push_back(FindEngine(argv[++i]));
+            if(engines.back() == NULL)
+            {
+                printf("ERROR, unknown engine %s!\n", argv[i]);
+                return -1;
+            }
+        }
+        // The router's own options, so their cost can be compared too
+        if(strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+        {
+            layers = atoi(argv[++i]);
+        }
+        if(strcmp(argv[i], "-w") == 0)
+        {
+            options.weighted = true;
+        }
+        if(strcmp(argv[i], "-c") == 0)
+        {
+            options.useRouteCache = true;
+        }
+        if(strcmp(argv[i], "-r") == 0)
+        {
+            options.ripUp = true;
+        }
+        if(strcmp(argv[i], "-t") == 0)
+        {
+            options.tiledLayout = true;
+        }
+        if(strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            options.timeBudget = atof(argv[++i]);
+        }
+        if(strcmp(argv[i], "-x") == 0 && i + 1 < argc)
+        {
+            options.expansionCap = strtoull(argv[++i], NULL, 10);
+        }
+        if(strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+        {
+            options.gridFilename = argv[++i];
+        }
+        if(strcmp(argv[i], "-k") == 0 && i + 1 < argc)
+        {
+            options.residentTiles = atoi(argv[++i]);
+        }
+        if(strcmp(argv[i], "-f") == 0)
+        {
+            options.reservePinAccess = true;
+        }
+        if(strcmp(argv[i], "-q") == 0 && i + 1 < argc)
+        {
+            if(!ParseRetryPolicy(argv[++i], &options.retryPolicy))
+            {
+                printf("ERROR, unknown retry policy %s!\n", argv[i]);
+                return -1;
+            }
+        }
+    }
+
+    if(engines.empty())
+    {
+        engines.push_back(&leeMooreEngine);
+        engines.push_back(&lineProbeEngine);
+        engines.push_back(&raceEngine);
+        engines.push_back(&channelEngine);
+    }
+    // With nothing given, benchmark the bundled inputs and a small and large generated grid
+    if(inputArguments.empty() && generatedSizes.empty())
+    {
+        inputArguments.push_back(BENCHMARK_DEFAULT_INPUTS);
+        generatedSizes.push_back(GENERATED_DEFAULT_SMALL);
+        generatedSizes.push_back(GENERATED_DEFAULT_LARGE);
+    }
+    for(i = 0; i < (int)inputArguments.size(); i++)
+    {
+        if(!ListInputFiles(inputArguments[i].c_str(), &inputFilenames))
+        {
+            return -1;
+        }
+    }
+
+    // Files first, then the generated grids from smallest to largest, the peak RSS only grows
+    // Every input is benchmarked with every engine before moving on to the next one
+    std::sort(generatedSizes.begin(), generatedSizes.end());
+    numInputs = inputFilenames.size() + generatedSizes.size();
+    results.resize(numInputs * engines.size());
+    for(i = 0; i < (int)results.size(); i++)
+    {
+        results[i].engine = engines[i % engines.size()];
+        if(i / engines.size() < inputFilenames.size())
+        {
+            results[i].name = inputFilenames[i / engines.size()];
+            results[i].filename = inputFilenames[i / engines.size()];
+            results[i].generatedSize = 0;
+        }
+        else
+        {
+            results[i].generatedSize = std::max(generatedSizes[i / engines.size() - inputFilenames.size()], 2u);
+            results[i].name = "generated " + std::to_string(results[i].generatedSize);
+        }
+    }
+
+    printf("Benchmarking %u engine(s) on %u input(s), %u run(s) each\n", (unsigned int)engines.size(), numInputs, runs);
+    benchmarked = true;
+    for(i = 0; i < (int)results.size(); i++)
+    {
+        printf("%s (%s)\n", results[i].name.c_str(), results[i].engine->name);
+        options.engine = results[i].engine;
+        benchmarked = BenchmarkInput(&results[i], &options, layers, runs) && benchmarked;
+    }
+
+    PrintResults(&results);
+    if(resultsFilename != NULL && !WriteResults(resultsFilename, &results, runs))
+    {
+        return -1;
+    }
+
+    return benchmarked ? 0 : 1;
+}
+
+bool BenchmarkInput(benchmarkResult_t *result, gridStruct_t *options, unsigned int layers, unsigned int runs)
+{
+    unsigned int run;
+    parsedInputStruct_t generatedInput = parsedInputStruct_t();
+
+    // Generate the grid once, it's the same for every run
+    if(result->generatedSize > 0)
+    {
+        GenerateBenchmarkGrid(result->generatedSize, &generatedInput);
+    }
+
+    result->parsed = true;
+    result->runs = 0;
+    result->routedRuns = 0;
+    result->fallbackNets = 0;
+    for(run = 0; run < runs; run++)
+    {
+        if(!BenchmarkRun(result, result->generatedSize > 0 ? &generatedInput : NULL, options, layers, run))
+        {
+            result->parsed = false;
+            return false;
+        }
+        result->runs++;
+    }
+    result->peakRss = GetPeakRss();
+
+    return true;
+}
+
+bool BenchmarkRun(benchmarkResult_t *result, parsedInputStruct_t *generatedInput, gridStruct_t *options, unsigned int layers, unsigned int run)
+{
+    parsedInputStruct_t runInput = parsedInputStruct_t();
+    gridStruct_t runGrid = gridStruct_t();
+    std::chrono::steady_clock::time_point startTime, phaseStart, attemptEnd, now;
+    benchmarkPhase_e phase, stepPhase;
+    unsigned long long cellsExpanded, before, after;
+    bool stepping, attemptDone;
+    double routeTime;
+    const char *filename;
+
+    // Every run shuffles the nets the same way in every build
+    runGrid.seed = BENCHMARK_SEED + run;
+    runGrid.rng.seed(runGrid.seed);
+    runGrid.engine = options->engine;
+    runGrid.weighted = options->weighted;
+    runGrid.useRouteCache = options->useRouteCache;
+    runGrid.ripUp = options->ripUp;
+    runGrid.tiledLayout = options->tiledLayout;
+    runGrid.timeBudget = options->timeBudget;
+    runGrid.expansionCap = options->expansionCap;
+    runGrid.retryPolicy = options->retryPolicy;
+    runGrid.reservePinAccess = options->reservePinAccess;
+    runGrid.gridFilename = options->gridFilename;
+    runGrid.residentTiles = options->residentTiles;
+
+    //1. Parse the input (generated grids are copied, there's nothing to parse)
+    if(generatedInput != NULL)
+    {
+        runInput = *generatedInput;
+    }
+    else
+    {
+        filename = result->filename.c_str();
+        startTime = std::chrono::steady_clock::now();
+        if(IsBinaryGridFile(filename) ? !LoadBinaryGrid(filename, &runInput, &runGrid) : !ParseInputFile(filename, &runInput, false))
+        {
+            return false;
+        }
+        result->samples[PHASE_PARSE].push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+    }
+    if(layers > 0)
+    {
+        runInput.gridSizeZ = layers;
+    }
+    result->gridSizeX = runInput.gridSizeX;
+    result->gridSizeY = runInput.gridSizeY;
+    result->gridSizeZ = runInput.gridSizeZ;
+    result->nets = (unsigned int)runInput.nodes.size();
+
+    //2. Build the grid from scratch (the router's own attempts restore it from its pristine image)
+    startTime = std::chrono::steady_clock::now();
+    if(!PopulateCellInfo(&runInput, &runGrid))
+    {
+        return false;
+    }
+    result->samples[PHASE_POPULATE].push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+
+    //3. Step through the route, only reading the clock when the router moves on to another phase
+    if(!RouterInit(&runInput, &runGrid))
+    {
+        return false;
+    }
+    RestoreSavedRouting(&runInput, &runGrid);
+    phase = PHASE_NUM;
+    cellsExpanded = 0;
+    attemptDone = false;
+    startTime = std::chrono::steady_clock::now();
+    phaseStart = startTime;
+    attemptEnd = startTime;
+    do
+    {
+        stepPhase = GetStepPhase(runGrid.currentRoutingState);
+        if(stepPhase != phase)
+        {
+            now = std::chrono::steady_clock::now();
+            if(phase != PHASE_NUM)
+            {
+                result->samples[phase].push_back(std::chrono::duration<double>(now - phaseStart).count());
+            }
+            phase = stepPhase;
+            phaseStart = now;
+        }
+
+        // The expansion counter starts over with every net
+        before = runGrid.currentTelemetry.cellsExpanded;
+        stepping = RouterStep(&runInput, &runGrid);
+        after = runGrid.currentTelemetry.cellsExpanded;
+        cellsExpanded += (after >= before) ? after - before : after;
+
+        // The first attempt is over once it succeeds or fails, anything after that is retries
+        if(!attemptDone && (runGrid.currentRoutingState == STATE_ROUTE_SUCCESS || runGrid.currentRoutingState == STATE_ROUTE_FAILURE))
+        {
+            attemptEnd = std::chrono::steady_clock::now();
+            result->samples[PHASE_ROUTE].push_back(std::chrono::duration<double>(attemptEnd - startTime).count());
+            attemptDone = true;
+        }
+    } while(stepping);
+
+    now = std::chrono::steady_clock::now();
+    if(phase != PHASE_NUM)
+    {
+        result->samples[phase].push_back(std::chrono::duration<double>(now - phaseStart).count());
+    }
+    if(runGrid.currentRetries > 0)
+    {
+        result->samples[PHASE_RETRIES].push_back(std::chrono::duration<double>(now - attemptEnd).count());
+    }
+    routeTime = std::chrono::duration<double>(now - startTime).count();
+    result->cellsPerSecond.push_back(routeTime > 0 ? cellsExpanded / routeTime : 0);
+    result->routedRuns += (runGrid.currentRoutingState == STATE_ROUTE_SUCCESS) ? 1 : 0;
+    result->fallbackNets += runGrid.fallbackNets;
+    UnmapGridFile(&runGrid.gridFile);
+
+    return true;
+}
+
+benchmarkPhase_e GetStepPhase(routingState_e state)
+{
+    // The phases of a net the engines go through
+    switch(state)
+    {
+        case STATE_SEEK:
+            return PHASE_SEEK;
+        case STATE_EXPANSION:
+            return PHASE_EXPANSION;
+        case STATE_WALKBACK:
+            return PHASE_WALKBACK;
+        default:
+            return PHASE_NUM;
+    }
+}
+
+void GenerateBenchmarkGrid(unsigned int size, parsedInputStruct_t *inputStruct)
+{
+    unsigned int i, j;
+    generatorOptions_t options;
+    generatedGrid_t grid;
+    posStruct_t pos;
+
+    // The same grid as "GridGenerator <file> -x size -y size -d density -n nets -w span -s seed", sparse enough to route
+    SetDefaultOptions(&options);
+    options.gridSizeX = size;
+    options.gridSizeY = size;
+    options.density = GENERATED_DENSITY;
+    options.numNets = std::max(size * size / GENERATED_CELLS_PER_NET, 1u);
+    options.netSpan = GENERATED_NET_SPAN;
+    options.seed = BENCHMARK_SEED + size;
+    GenerateGrid(&options, &grid);
+
+    // Hand it over like a parsed input
+    inputStruct->gridSizeX = options.gridSizeX;
+    inputStruct->gridSizeY = options.gridSizeY;
+    inputStruct->gridSizeZ = options.gridSizeZ;
+    pos.posZ = 0;
+    for(i = 0; i < grid.blocked.size(); i++)
+    {
+        if(grid.blocked[i])
+        {
+            pos.posX = i % options.gridSizeX;
+            pos.posY = i / options.gridSizeX;
+            inputStruct->obstructions.push_back(pos);
+        }
+    }
+    inputStruct->nodes.resize(grid.nets.size());
+    for(i = 0; i < grid.nets.size(); i++)
+    {
+        for(j = 0; j < grid.nets[i].size(); j++)
+        {
+            pos.posX = grid.nets[i][j] % options.gridSizeX;
+            pos.posY = grid.nets[i][j] / options.gridSizeX;
+            inputStruct->nodes[i].push_back(pos);
+        }
+    }
+}
+
+double GetPercentile(std::vector<double> *samples, double percentile)
+{
+    std::vector<double> sorted;
+    size_t rank;
+
+    if(samples->empty())
+    {
+        return 0;
+    }
+    // Nearest rank
+    sorted = *samples;
+    std::sort(sorted.begin(), sorted.end());
+    rank = (size_t)std::ceil(percentile * sorted.size());
+    return sorted[std::min(std::max(rank, (size_t)1), sorted.size()) - 1];
+}
+
+unsigned long long GetPeakRss(void)
+{
+#ifdef WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+
+    if(!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    {
+        return 0;
+    }
+    return counters.PeakWorkingSetSize;
+#else
+    struct rusage usage;
+
+    if(getrusage(RUSAGE_SELF, &usage) != 0)
+    {
+        return 0;
+    }
+#ifdef __APPLE__
+    return usage.ru_maxrss;
+#else
+    // Linux gives kilobytes
+    return (unsigned long long)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+void PrintResults(std::vector<benchmarkResult_t> *results)
+{
+    unsigned int i, phase;
+    benchmarkResult_t *result;
+    char strBuff[80];
+
+    printf("\n%-40s %-10s %15s %6s %-10s %8s %12s %12s\n", "input", "engine", "grid", "nets", "phase", "samples", "median ms", "p95 ms");
+    for(i = 0; i < results->size(); i++)
+    {
+        result = &(*results)[i];
+        if(!result->parsed)
+        {
+            printf("%-40s %-10s %15s\n", result->name.c_str(), result->engine->name, "parse error");
+            continue;
+        }
+        sprintf(strBuff, "%ux%ux%u", result->gridSizeX, result->gridSizeY, result->gridSizeZ);
+        for(phase = 0; phase < PHASE_NUM; phase++)
+        {
+            // Routers only go through some of the phases, and retries only happen when the first attempt fails
+            if(result->samples[phase].empty())
+            {
+                continue;
+            }
+            printf("%-40s %-10s %15s %6u %-10s %8u %12.4f %12.4f\n", result->name.c_str(), result->engine->name, strBuff, result->nets, phaseNames[phase],
+                (unsigned int)result->samples[phase].size(), GetPercentile(&result->samples[phase], 0.5) * 1000,
+                GetPercentile(&result->samples[phase], BENCHMARK_PERCENTILE) * 1000);
+        }
+        printf("%-40s %-10s %15s %6u %.0f cells expanded/s, peak RSS %.1f MB, %u of %u run(s) routed", result->name.c_str(), result->engine->name, strBuff, result->nets,
+            GetPercentile(&result->cellsPerSecond, 0.5), result->peakRss / (1024.0 * 1024.0), result->routedRuns, result->runs);
+        if(result->engine->fallback != NULL)
+        {
+            printf(", %u net(s) fell back to %s", result->fallbackNets, result->engine->fallback->name);
+        }
+        printf("\n");
+    }
+}
+
+bool WriteResults(const char *filename, std::vector<benchmarkResult_t> *results, unsigned int runs)
+{
+    unsigned int i, phase;
+    bool first;
+    FILE *outputFile;
+    benchmarkResult_t *result;
+
+    outputFile = fopen(filename, "w");
+    if(outputFile == NULL)
+    {
+        printf("ERROR, file %s couldn't be opened for writing!\n", filename);
+        return false;
+    }
+
+    fprintf(outputFile, "{\n  \"runs\": %u,\n  \"percentile\": %.2f,\n  \"inputs\": [\n", runs, BENCHMARK_PERCENTILE);
+    for(i = 0; i < results->size(); i++)
+    {
+        result = &(*results)[i];
+        fprintf(outputFile, "    {\"input\": ");
+        WriteJsonString(outputFile, result->name.c_str());
+        fprintf(outputFile, ", \"engine\": ");
+        WriteJsonString(outputFile, result->engine->name);
+        if(result->parsed)
+        {
+            fprintf(outputFile, ", \"grid\": [%u, %u, %u], \"nets\": %u, \"runs\": %u, \"routedRuns\": %u, \"fallbackNets\": %u, "
+                "\"cellsExpandedPerSecond\": %.0f, \"peakRssBytes\": %llu, \"phases\": {",
+                result->gridSizeX, result->gridSizeY, result->gridSizeZ, result->nets, result->runs, result->routedRuns, result->fallbackNets,
+                GetPercentile(&result->cellsPerSecond, 0.5), result->peakRss);
+            first = true;
+            for(phase = 0; phase < PHASE_NUM; phase++)
+            {
+                if(result->samples[phase].empty())
+                {
+                    continue;
+                }
+                fprintf(outputFile, "%s\"%s\": {\"samples\": %u, \"medianSeconds\": %.9f, \"p95Seconds\": %.9f}", first ? "" : ", ",
+                    phaseNames[phase], (unsigned int)result->samples[phase].size(), GetPercentile(&result->samples[phase], 0.5),
+                    GetPercentile(&result->samples[phase], BENCHMARK_PERCENTILE));
+                first = false;
+            }
+            fprintf(outputFile, "}");
+        }
+        else
+        {
+            fprintf(outputFile, ", \"error\": \"parse error\"");
+        }
+        fprintf(outputFile, "}%s\n", (i + 1 < results->size()) ? "," : "");
+    }
+    fprintf(outputFile, "  ]\n}\n");
+
+    if(fclose(outputFile) != 0)
+    {
+        printf("ERROR, couldn't write results %s!\n", filename);
+        return false;
+    }
+    printf("Saved results to %s\n", filename);
+
+    return true;
+}
+
+void WriteJsonString(FILE *outputFile, const char *value)
+{
+    // Windows paths are full of backslashes
+    fputc('"', outputFile);
+    for(; *value != '\0'; value++)
+    {
+        if(*value == '"' || *value == '\\')
+        {
+            fputc('\\', outputFile);
+        }
+        fputc(*value, outputFile);
+    }
+    fputc('"', outputFile);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "../RouterCore/RouterCore.h"
+#include "../GridGenerator/GridGenerator.h"
+
+// Constants used in the benchmark
+#define BENCHMARK_DEFAULT_RUNS      5                   ///< Runs of every input when it isn't given
+#define BENCHMARK_DEFAULT_INPUTS    "../benchmarks"     ///< Inputs benchmarked when none are given
+#define BENCHMARK_SEED              1                   ///< Seeds the net order shuffles and the generated grids, so every build routes the same nets in the same order
+#define BENCHMARK_PERCENTILE        0.95                ///< The tail percentile reported next to the median
+
+// Constants used in generated grids
+#define GENERATED_DEFAULT_SMALL     256     ///< Size of the smaller grid generated when no inputs are given
+#define GENERATED_DEFAULT_LARGE     1024    ///< Size of the larger grid generated when no inputs are given
+#define GENERATED_DENSITY           0.1     ///< Fraction of the cells obstructed
+#define GENERATED_CELLS_PER_NET     2000    ///< Cells of the grid for every net
+#define GENERATED_NET_SPAN          16      ///< Width and height of the window a net's pins are picked in
+
+// This enum contains the parts of routing that are timed
+typedef enum
+{
+    PHASE_PARSE = 0,    ///< Parsing the input file (or loading the binary grid)
+    PHASE_POPULATE,     ///< Building the grid from scratch
+    PHASE_SEEK,         ///< One line probe seek (line probing engines only)
+    PHASE_EXPANSION,    ///< One expansion towards the next pin (includes its walkback when line probing)
+    PHASE_WALKBACK,     ///< One walkback from a pin that was reached (Lee Moore only)
+    PHASE_ROUTE,        ///< The first attempt at routing the whole grid
+    PHASE_RETRIES,      ///< Every attempt after the first, when the first one failed
+    PHASE_NUM
+} benchmarkPhase_e;
+
+// This struct contains an input's benchmark results
+typedef struct
+{
+    std::string                 name;                       ///< The input file, or the size of a generated grid
+    std::string                 filename;                   ///< The input file (empty for generated grids)
+    const routerEngine_t        *engine;                    ///< The engine the input was routed with
+    unsigned int                generatedSize;              ///< The width and height of a generated grid
+    bool                        parsed;                     ///< Whether the input was parsed, the rest is only filled in if it was
+
+    unsigned int                gridSizeX;                  ///< The grid size in X
+    unsigned int                gridSizeY;                  ///< The grid size in Y
+    unsigned int                gridSizeZ;                  ///< The number of routing layers
+    unsigned int                nets;                       ///< The number of nets
+    unsigned int                runs;                       ///< The number of runs
+    unsigned int                routedRuns;                 ///< The number of runs that routed every net
+    unsigned int                fallbackNets;               ///< The nets handed to the engine's fallback in the last attempt of every run
+
+    std::vector<double>         samples[PHASE_NUM];         ///< Every timed sample of each phase, in seconds
+    std::vector<double>         cellsPerSecond;             ///< Cells expanded per second of routing, one per run
+    unsigned long long          peakRss;                    ///< The process' peak resident set size once the input was done, in bytes
+} benchmarkResult_t;
+
+// Benchmark
+bool BenchmarkInput(benchmarkResult_t *result, gridStruct_t *options, unsigned int layers, unsigned int runs);
+bool BenchmarkRun(benchmarkResult_t *result, parsedInputStruct_t *generatedInput, gridStruct_t *options, unsigned int layers, unsigned int run);
+benchmarkPhase_e GetStepPhase(routingState_e state);
+void GenerateBenchmarkGrid(unsigned int size, parsedInputStruct_t *inputStruct);
+
+// Results
+double GetPercentile(std::vector<double> *samples, double percentile);
+unsigned long long GetPeakRss(void);
+void PrintResults(std::vector<benchmarkResult_t> *results);
+bool WriteResults(const char *filename, std::vector<benchmarkResult_t> *results, unsigned int runs);
+void WriteJsonString(FILE *outputFile, const char *value);
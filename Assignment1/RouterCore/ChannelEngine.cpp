@@ -0,0 +1,435 @@
+#define _CRT_SECURE_NO_WARNINGS //  Disable unsafe warnings, to enable use of sprintf within VS2017
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "RouterCore.h"
+
+// Channel routing lays a net's connections within the channels between rows of cells along tracks planned with the left edge algorithm,
+// Lee Moore only routes the connections between channels (and takes the whole net over if they can't be made)
+const routerEngine_t channelEngine =
+{
+    "channel",
+    "Channel",
+    CHANNEL_ROUTING_RETRIES,
+    &leeMooreEngine,
+    ChannelInit,
+    ChannelBeginNet,
+    ChannelStep
+};
+
+void ChannelInit(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, j, planned;
+    int channel;
+    unsigned long long cell;
+    posStruct_t *pin;
+    std::vector<int> rowChannels;
+    std::vector<int> occupancy;
+    std::vector<int> netSegments;
+    std::vector<channelSegment_t> newSegments;
+    std::vector<std::vector<std::pair<unsigned int, unsigned int>>> channelOrder;
+    std::vector<unsigned int> channelPins;
+    std::vector<std::vector<posStruct_t>> newNodes;
+
+    //1. Find the channels and which channel every row is in
+    FindChannels(parsedInputStruct, gridStruct);
+    rowChannels.assign(parsedInputStruct->gridSizeZ * parsedInputStruct->gridSizeY, -1);
+    for(i = 0; i < gridStruct->channels.size(); i++)
+    {
+        for(j = gridStruct->channels[i].top; j <= gridStruct->channels[i].bottom; j++)
+        {
+            rowChannels[gridStruct->channels[i].posZ * parsedInputStruct->gridSizeY + j] = i;
+        }
+    }
+
+    //2. Group every net's pins by the channel they're in, a channel with two or more of a net's pins needs a connection within it
+    gridStruct->channelSegments.clear();
+    gridStruct->channelPinSegments.clear();
+    netSegments.assign(gridStruct->channels.size(), -1);
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        newSegments.clear();
+        for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+        {
+            pin = &parsedInputStruct->nodes[i][j];
+            if(pin->posZ >= parsedInputStruct->gridSizeZ)
+            {
+                continue;
+            }
+            channel = rowChannels[pin->posZ * parsedInputStruct->gridSizeY + pin->posY];
+            if(channel < 0)
+            {
+                continue;
+            }
+            if(netSegments[channel] < 0)
+            {
+                netSegments[channel] = newSegments.size();
+                newSegments.push_back(channelSegment_t());
+                newSegments.back().channel = channel;
+                newSegments.back().net = i;
+                newSegments.back().left = pin->posX;
+                newSegments.back().right = pin->posX;
+                newSegments.back().planned = false;
+                newSegments.back().track = 0;
+            }
+            newSegments[netSegments[channel]].pins.push_back(*pin);
+            newSegments[netSegments[channel]].left = std::min(newSegments[netSegments[channel]].left, pin->posX);
+            newSegments[netSegments[channel]].right = std::max(newSegments[netSegments[channel]].right, pin->posX);
+        }
+        for(j = 0; j < newSegments.size(); j++)
+        {
+            netSegments[newSegments[j].channel] = -1;
+            if(newSegments[j].pins.size() > 1)
+            {
+                gridStruct->channelSegments.push_back(newSegments[j]);
+            }
+        }
+    }
+
+    //3. Mark the cells the plan has to keep clear of, then plan every channel's connections onto its tracks
+    occupancy.assign((unsigned long long)parsedInputStruct->gridSizeZ * parsedInputStruct->gridSizeY * parsedInputStruct->gridSizeX, -1);
+    for(i = 0; i < parsedInputStruct->obstructions.size(); i++)
+    {
+        if(parsedInputStruct->obstructions[i].posZ < parsedInputStruct->gridSizeZ)
+        {
+            cell = ((unsigned long long)parsedInputStruct->obstructions[i].posZ * parsedInputStruct->gridSizeY + parsedInputStruct->obstructions[i].posY) * parsedInputStruct->gridSizeX + parsedInputStruct->obstructions[i].posX;
+            occupancy[cell] = -2;
+        }
+    }
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+        {
+            pin = &parsedInputStruct->nodes[i][j];
+            if(pin->posZ < parsedInputStruct->gridSizeZ)
+            {
+                cell = ((unsigned long long)pin->posZ * parsedInputStruct->gridSizeY + pin->posY) * parsedInputStruct->gridSizeX + pin->posX;
+                occupancy[cell] = i;
+            }
+        }
+    }
+    channelOrder.resize(gridStruct->channels.size());
+    for(i = 0; i < gridStruct->channelSegments.size(); i++)
+    {
+        channelOrder[gridStruct->channelSegments[i].channel].push_back(std::make_pair(gridStruct->channelSegments[i].left, i));
+    }
+    for(i = 0; i < gridStruct->channels.size(); i++)
+    {
+        PlanChannel(parsedInputStruct, gridStruct, i, &channelOrder[i], &occupancy);
+    }
+
+    //4. Remember which planned connection every pin belongs to
+    planned = 0;
+    channelPins.assign(parsedInputStruct->nodes.size(), 0);
+    for(i = 0; i < gridStruct->channelSegments.size(); i++)
+    {
+        if(!gridStruct->channelSegments[i].planned)
+        {
+            continue;
+        }
+        planned++;
+        channelPins[gridStruct->channelSegments[i].net] += gridStruct->channelSegments[i].pins.size();
+        for(j = 0; j < gridStruct->channelSegments[i].pins.size(); j++)
+        {
+            pin = &gridStruct->channelSegments[i].pins[j];
+            cell = ((unsigned long long)pin->posZ * parsedInputStruct->gridSizeY + pin->posY) * parsedInputStruct->gridSizeX + pin->posX;
+            gridStruct->channelPinSegments[cell] = i;
+        }
+    }
+
+    //5. Route the nets that don't leave their channels first, so Lee Moore's connections between channels go around their tracks
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        if(channelPins[i] == parsedInputStruct->nodes[i].size())
+        {
+            newNodes.push_back(parsedInputStruct->nodes[i]);
+        }
+    }
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        if(channelPins[i] != parsedInputStruct->nodes[i].size())
+        {
+            newNodes.push_back(parsedInputStruct->nodes[i]);
+        }
+    }
+    parsedInputStruct->nodes = newNodes;
+
+    if(gridStruct->verbose)
+    {
+        printf("Found %d channel(s), planned %d of %d connection(s) within them\n", (int)gridStruct->channels.size(), planned, (int)gridStruct->channelSegments.size());
+    }
+}
+
+void ChannelBeginNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    // Lay the connections in the source's channel, Lee Moore routes whatever is left from them
+    LayChannelSegments(parsedInputStruct, gridStruct);
+    if(gridStruct->netRoutedNodes[gridStruct->currentNet] == 0)
+    {
+        FinishNet(parsedInputStruct, gridStruct);
+        return;
+    }
+    LeeMooreBeginNet(parsedInputStruct, gridStruct);
+}
+
+void ChannelStep(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    routingState_e previousState;
+
+    previousState = gridStruct->currentRoutingState;
+    LeeMooreStep(parsedInputStruct, gridStruct);
+
+    // Every pin Lee Moore connects brings the connection in its channel along with it
+    if(previousState == STATE_WALKBACK && gridStruct->currentRoutingState == STATE_EXPANSION &&
+        LayChannelSegments(parsedInputStruct, gridStruct) && gridStruct->netRoutedNodes[gridStruct->currentNet] == 0)
+    {
+        FinishNet(parsedInputStruct, gridStruct);
+    }
+}
+
+void FindChannels(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int y, z;
+    bool layerBlocked;
+    std::vector<bool> rowBlocked;
+    routingChannel_t channel;
+
+    // Rows with an obstruction in them are rows of cells
+    rowBlocked.assign(parsedInputStruct->gridSizeZ * parsedInputStruct->gridSizeY, false);
+    for(y = 0; y < parsedInputStruct->obstructions.size(); y++)
+    {
+        if(parsedInputStruct->obstructions[y].posZ < parsedInputStruct->gridSizeZ)
+        {
+            rowBlocked[parsedInputStruct->obstructions[y].posZ * parsedInputStruct->gridSizeY + parsedInputStruct->obstructions[y].posY] = true;
+        }
+    }
+
+    // The bands of free rows between them are channels (a layer without any rows of cells has no channel structure and is left to Lee Moore)
+    gridStruct->channels.clear();
+    for(z = 0; z < parsedInputStruct->gridSizeZ; z++)
+    {
+        layerBlocked = false;
+        for(y = 0; y < parsedInputStruct->gridSizeY; y++)
+        {
+            layerBlocked = layerBlocked || rowBlocked[z * parsedInputStruct->gridSizeY + y];
+        }
+        if(!layerBlocked)
+        {
+            continue;
+        }
+        channel.posZ = z;
+        for(y = 0; y < parsedInputStruct->gridSizeY; y++)
+        {
+            if(rowBlocked[z * parsedInputStruct->gridSizeY + y])
+            {
+                continue;
+            }
+            if(y == 0 || rowBlocked[z * parsedInputStruct->gridSizeY + y - 1])
+            {
+                channel.top = y;
+            }
+            if(y == parsedInputStruct->gridSizeY - 1 || rowBlocked[z * parsedInputStruct->gridSizeY + y + 1])
+            {
+                channel.bottom = y;
+                gridStruct->channels.push_back(channel);
+            }
+        }
+    }
+}
+
+void PlanChannel(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, unsigned int channel, std::vector<std::pair<unsigned int, unsigned int>> *segments, std::vector<int> *occupancy)
+{
+    unsigned int i, k, top, bottom, middle;
+    int lastRight;
+    std::vector<unsigned int> tracks;
+    channelSegment_t *segment;
+
+    //1. Left edge order (ties keep the shuffled net order, so every attempt packs the tracks differently)
+    std::stable_sort(segments->begin(), segments->end());
+
+    //2. Fill the tracks from the middle of the channel out, the rows along its edges are where the pins are
+    top = gridStruct->channels[channel].top;
+    bottom = gridStruct->channels[channel].bottom;
+    middle = (top + bottom) / 2;
+    tracks.push_back(middle);
+    for(k = 1; tracks.size() < bottom - top + 1; k++)
+    {
+        if(middle >= top + k)
+        {
+            tracks.push_back(middle - k);
+        }
+        if(middle + k <= bottom)
+        {
+            tracks.push_back(middle + k);
+        }
+    }
+
+    //3. Pack each track from the left with every connection that starts past the last one on it and has its branches clear
+    for(k = 0; k < tracks.size(); k++)
+    {
+        lastRight = -1;
+        for(i = 0; i < segments->size(); i++)
+        {
+            segment = &gridStruct->channelSegments[(*segments)[i].second];
+            if(segment->planned || (int)segment->left <= lastRight)
+            {
+                continue;
+            }
+            if(FitSegment(parsedInputStruct, gridStruct, segment, tracks[k], occupancy))
+            {
+                lastRight = segment->right;
+            }
+        }
+    }
+}
+
+bool FitSegment(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, channelSegment_t *segment, unsigned int track, std::vector<int> *occupancy)
+{
+    unsigned int i, x, y;
+    unsigned long long cell;
+    bool fits;
+    posStruct_t pos;
+    std::vector<posStruct_t> path;
+
+    // The cells are claimed as they're checked, so branches that overlap the trunk or each other are only laid once
+    fits = true;
+    pos.posZ = gridStruct->channels[segment->channel].posZ;
+
+    //1. The trunk, from the leftmost pin to the rightmost
+    pos.posY = track;
+    for(x = segment->left; x <= segment->right && fits; x++)
+    {
+        cell = ((unsigned long long)pos.posZ * parsedInputStruct->gridSizeY + track) * parsedInputStruct->gridSizeX + x;
+        if((*occupancy)[cell] == (int)segment->net)
+        {
+            continue;
+        }
+        fits = ((*occupancy)[cell] == -1);
+        if(fits)
+        {
+            (*occupancy)[cell] = segment->net;
+            pos.posX = x;
+            path.push_back(pos);
+        }
+    }
+
+    //2. A branch straight up or down from every pin to the trunk
+    for(i = 0; i < segment->pins.size() && fits; i++)
+    {
+        pos.posX = segment->pins[i].posX;
+        y = segment->pins[i].posY;
+        while(y != track && fits)
+        {
+            y = (y < track) ? y + 1 : y - 1;
+            cell = ((unsigned long long)pos.posZ * parsedInputStruct->gridSizeY + y) * parsedInputStruct->gridSizeX + pos.posX;
+            if((*occupancy)[cell] == (int)segment->net)
+            {
+                continue;
+            }
+            fits = ((*occupancy)[cell] == -1);
+            if(fits)
+            {
+                (*occupancy)[cell] = segment->net;
+                pos.posY = y;
+                path.push_back(pos);
+            }
+        }
+    }
+
+    //3. Give back what we claimed if it doesn't fit
+    if(!fits)
+    {
+        for(i = 0; i < path.size(); i++)
+        {
+            cell = ((unsigned long long)path[i].posZ * parsedInputStruct->gridSizeY + path[i].posY) * parsedInputStruct->gridSizeX + path[i].posX;
+            (*occupancy)[cell] = -1;
+        }
+        return false;
+    }
+
+    segment->planned = true;
+    segment->track = track;
+    segment->path = path;
+    return true;
+}
+
+bool LayChannelSegments(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, j;
+    unsigned long long cell;
+    bool laid, pending, blocked;
+    cellStruct_t *currentCell;
+    cellStruct_t *pinCell;
+    channelSegment_t *segment;
+    std::vector<posStruct_t> *netNodes;
+    std::unordered_map<unsigned long long, unsigned int>::iterator entry;
+
+    laid = false;
+    netNodes = &parsedInputStruct->nodes[gridStruct->currentNet];
+    for(i = 0; i < netNodes->size(); i++)
+    {
+        //1. Find the connected pins with a planned connection
+        pinCell = GetCell(gridStruct, (*netNodes)[i].posX, (*netNodes)[i].posY, (*netNodes)[i].posZ);
+        if(pinCell->currentCellProp != CELL_NET_SOURCE && pinCell->currentCellProp != CELL_NET_SINK_CONN)
+        {
+            continue;
+        }
+        cell = ((unsigned long long)(*netNodes)[i].posZ * parsedInputStruct->gridSizeY + (*netNodes)[i].posY) * parsedInputStruct->gridSizeX + (*netNodes)[i].posX;
+        entry = gridStruct->channelPinSegments.find(cell);
+        if(entry == gridStruct->channelPinSegments.end())
+        {
+            continue;
+        }
+        segment = &gridStruct->channelSegments[entry->second];
+
+        //2. Skip it if it's been laid already, or if an earlier net has taken one of its cells (Lee Moore connects its pins instead)
+        pending = false;
+        for(j = 0; j < segment->pins.size(); j++)
+        {
+            currentCell = GetCell(gridStruct, segment->pins[j].posX, segment->pins[j].posY, segment->pins[j].posZ);
+            pending = pending || (currentCell->currentCellProp == CELL_NET_SINK_UNCONN);
+        }
+        blocked = false;
+        for(j = 0; j < segment->path.size() && pending && !blocked; j++)
+        {
+            currentCell = GetCell(gridStruct, segment->path[j].posX, segment->path[j].posY, segment->path[j].posZ);
+            blocked = (currentCell->currentCellProp != CELL_EMPTY || IsReservedCell(gridStruct, currentCell));
+        }
+        if(!pending || blocked)
+        {
+            continue;
+        }
+
+        //3. Lay the trunk and branches, and connect the pins
+        if(gridStruct->verbose)
+        {
+            printf("Laying net %d's connection along track %d, %d to %d\n", gridStruct->currentNet, segment->track, segment->left, segment->right);
+        }
+        if(pinCell->currentCellProp == CELL_NET_SOURCE)
+        {
+            gridStruct->lastRoute.push_back(pinCell);
+        }
+        for(j = 0; j < segment->path.size(); j++)
+        {
+            currentCell = GetCell(gridStruct, segment->path[j].posX, segment->path[j].posY, segment->path[j].posZ);
+            SetCellNet(gridStruct, currentCell, gridStruct->currentNet);
+            SetCellProp(gridStruct, currentCell, CELL_NET_WIRE_CONN);
+            gridStruct->lastRoute.push_back(currentCell);
+        }
+        for(j = 0; j < segment->pins.size(); j++)
+        {
+            currentCell = GetCell(gridStruct, segment->pins[j].posX, segment->pins[j].posY, segment->pins[j].posZ);
+            if(currentCell->currentCellProp == CELL_NET_SINK_UNCONN)
+            {
+                SetCellProp(gridStruct, currentCell, CELL_NET_SINK_CONN);
+                gridStruct->lastRoute.push_back(currentCell);
+                gridStruct->netRoutedNodes[gridStruct->currentNet]--;
+            }
+        }
+        laid = true;
+    }
+
+    return laid;
+}
@@ -0,0 +1,832 @@
+#define _CRT_SECURE_NO_WARNINGS //  Disable unsafe warnings, to enable use of sprintf within VS2017
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#ifndef WIN32
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+#include "RouterCore.h"
+
+#ifndef MSG_NOSIGNAL
+#define MSG_NOSIGNAL 0
+#endif
+
+// Domain decomposition splits the grid into rectangles, each routed by its own worker process that only ever sees its domain and a halo of its
+// neighbours' cells around it. The workers route the nets within their domains all at once, then take turns routing the nets reaching into their
+// halos while the coordinator passes every routed cell on to the workers whose halos it's in. The nets left over are routed on the whole grid.
+// The workers only talk to the coordinator through their sockets, the messages don't depend on the workers sharing a machine with it.
+
+bool RouteDomains(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, unsigned int domainsX, unsigned int domainsY)
+{
+#ifdef WIN32
+    printf("ERROR, routing in domains needs fork() and UNIX sockets, route without -u on Windows!\n");
+    return false;
+#else
+    unsigned int i, j, k, d, phase, numRouted, numWires, net, domainRouted, haloRouted;
+    bool valid;
+    size_t cursor;
+    unsigned long long cell;
+    posStruct_t pos;
+    domainMessage_e type;
+    std::vector<routingDomain_t> domains;
+    std::vector<int> netDomains;
+    std::vector<unsigned int> netPhases;
+    std::vector<bool> netRouted;
+    std::vector<bool> participants;
+    std::vector<unsigned int> payload;
+    std::chrono::steady_clock::time_point startTime;
+
+    if(!gridStruct->savedRouting.netPlane.empty())
+    {
+        printf("ERROR, can't route a grid that already has a saved routing in domains!\n");
+        return false;
+    }
+    if(domainsX == 0 || domainsY == 0 || domainsX > parsedInputStruct->gridSizeX || domainsY > parsedInputStruct->gridSizeY)
+    {
+        printf("ERROR, can't split a %d x %d grid into %d x %d domains!\n", parsedInputStruct->gridSizeX, parsedInputStruct->gridSizeY, domainsX, domainsY);
+        return false;
+    }
+    startTime = std::chrono::steady_clock::now();
+
+    //1. Split the grid and hand every net to a domain that sees all of its pins, the rest are left for the whole grid
+    SplitDomains(parsedInputStruct, domainsX, domainsY, &domains);
+    netDomains.assign(parsedInputStruct->nodes.size(), -1);
+    netPhases.assign(parsedInputStruct->nodes.size(), 0);
+    netRouted.assign(parsedInputStruct->nodes.size(), false);
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        valid = !parsedInputStruct->nodes[i].empty();
+        for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+        {
+            valid = valid && parsedInputStruct->nodes[i][j].posZ < parsedInputStruct->gridSizeZ;
+        }
+        if(valid)
+        {
+            netDomains[i] = AssignDomainNet(&domains, &parsedInputStruct->nodes[i], &netPhases[i]);
+        }
+        if(netDomains[i] >= 0)
+        {
+            domains[netDomains[i]].nets.push_back(i);
+        }
+    }
+
+    //2. Start a worker for every domain and send it its window, the nets on a domain without a worker are left for the whole grid
+    for(i = 0; i < domains.size(); i++)
+    {
+        if(!StartDomainWorker(&domains, i))
+        {
+            printf("Couldn't start a worker for domain %d, its nets are left for the whole grid\n", i);
+            continue;
+        }
+        GetDomainProblem(parsedInputStruct, gridStruct, &domains, &netDomains, &netPhases, i, &payload);
+        if(!WriteDomainMessage(domains[i].socket, DOMAIN_MSG_PROBLEM, &payload))
+        {
+            printf("Lost the worker for domain %d, its nets are left for the whole grid\n", i);
+            close(domains[i].socket);
+            domains[i].socket = -1;
+        }
+    }
+
+    //3. Route the nets within every domain at once, then the nets reaching into the halos one colour of the checkerboard at a time
+    gridStruct->savedRouting.netPlane.assign((unsigned long long)parsedInputStruct->gridSizeX * parsedInputStruct->gridSizeY * parsedInputStruct->gridSizeZ, -1);
+    domainRouted = 0;
+    haloRouted = 0;
+    for(phase = 0; phase <= DOMAIN_HALO_PHASES; phase++)
+    {
+        // Every worker with nets in the phase gets the cells the others routed in its window since it was last told
+        participants.assign(domains.size(), false);
+        for(i = 0; i < domains.size(); i++)
+        {
+            for(j = 0; j < domains[i].nets.size() && domains[i].socket >= 0; j++)
+            {
+                if(!netRouted[domains[i].nets[j]] && netPhases[domains[i].nets[j]] == phase)
+                {
+                    participants[i] = true;
+                }
+            }
+            if(!participants[i])
+            {
+                continue;
+            }
+            payload.clear();
+            payload.push_back(phase);
+            payload.push_back(domains[i].haloUpdates.size());
+            for(j = 0; j < domains[i].haloUpdates.size(); j++)
+            {
+                PutDomainPos(&payload, &domains[i].haloUpdates[j]);
+            }
+            domains[i].haloUpdates.clear();
+            if(!WriteDomainMessage(domains[i].socket, DOMAIN_MSG_ROUTE, &payload))
+            {
+                printf("Lost the worker for domain %d, its nets are left for the whole grid\n", i);
+                close(domains[i].socket);
+                domains[i].socket = -1;
+                participants[i] = false;
+            }
+        }
+
+        // The workers route their phases side by side, take in what they routed as they finish
+        for(i = 0; i < domains.size(); i++)
+        {
+            if(!participants[i])
+            {
+                continue;
+            }
+            cursor = 0;
+            valid = ReadDomainMessage(domains[i].socket, &type, &payload) && type == DOMAIN_MSG_ROUTED && TakeDomainValue(&payload, &cursor, &numRouted);
+            for(j = 0; j < numRouted && valid; j++)
+            {
+                valid = TakeDomainValue(&payload, &cursor, &net) && TakeDomainValue(&payload, &cursor, &numWires) &&
+                    net < netDomains.size() && netDomains[net] == (int)i && !netRouted[net];
+                for(k = 0; k < numWires && valid; k++)
+                {
+                    valid = TakeDomainPos(&payload, &cursor, &pos) && IsInDomain(&domains[i], &pos, true) && pos.posZ < parsedInputStruct->gridSizeZ;
+                    if(!valid)
+                    {
+                        break;
+                    }
+                    cell = ((unsigned long long)pos.posZ * parsedInputStruct->gridSizeY + pos.posY) * parsedInputStruct->gridSizeX + pos.posX;
+                    gridStruct->savedRouting.netPlane[cell] = net;
+                    // This is the halo exchange, the cell is passed on to every other worker that can see it
+                    for(d = 0; d < domains.size(); d++)
+                    {
+                        if(d != i && IsInDomain(&domains[d], &pos, true))
+                        {
+                            domains[d].haloUpdates.push_back(pos);
+                        }
+                    }
+                }
+                if(valid)
+                {
+                    netRouted[net] = true;
+                    if(phase == 0)
+                    {
+                        domainRouted++;
+                    }
+                    else
+                    {
+                        haloRouted++;
+                    }
+                }
+            }
+            if(!valid)
+            {
+                printf("Lost the worker for domain %d, its nets are left for the whole grid\n", i);
+                close(domains[i].socket);
+                domains[i].socket = -1;
+                continue;
+            }
+            // The worker gives the nets it couldn't route within its domain another go in its halo phase, keep track of them the same way
+            for(j = 0; j < domains[i].nets.size() && phase == 0; j++)
+            {
+                if(!netRouted[domains[i].nets[j]])
+                {
+                    netPhases[domains[i].nets[j]] = domains[i].haloPhase;
+                }
+            }
+        }
+    }
+
+    //4. Let the workers go
+    for(i = 0; i < domains.size(); i++)
+    {
+        if(domains[i].socket >= 0)
+        {
+            payload.clear();
+            WriteDomainMessage(domains[i].socket, DOMAIN_MSG_DONE, &payload);
+            close(domains[i].socket);
+            domains[i].socket = -1;
+        }
+    }
+    for(i = 0; i < domains.size(); i++)
+    {
+        if(domains[i].processId > 0)
+        {
+            waitpid(domains[i].processId, NULL, 0);
+        }
+    }
+
+    //5. The domains' routing becomes the grid's saved routing, the nets left over are routed on the whole grid from there
+    // (a net's wires are only laid back down if it was routed, wires of a worker lost half way through are ignored)
+    gridStruct->savedRouting.netPins.clear();
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        gridStruct->savedRouting.netPins.push_back(parsedInputStruct->nodes[i].empty() ? posStruct_t() : parsedInputStruct->nodes[i][0]);
+    }
+    gridStruct->savedRouting.netRouted = netRouted;
+    printf("%d domain(s) routed %d of %d nets in %.3f s (%d within a domain, %d into a halo), %d left for the whole grid\n", (int)domains.size(),
+        domainRouted + haloRouted, (int)parsedInputStruct->nodes.size(), std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count(),
+        domainRouted, haloRouted, (int)parsedInputStruct->nodes.size() - domainRouted - haloRouted);
+
+    return true;
+#endif
+}
+
+void SplitDomains(parsedInputStruct_t *parsedInputStruct, unsigned int domainsX, unsigned int domainsY, std::vector<routingDomain_t> *domains)
+{
+    unsigned int i, j, halo;
+    routingDomain_t domain;
+
+    // A halo is at most half as wide as the narrowest domain, so the halos of two domains of the same colour never overlap
+    halo = std::min((unsigned int)DOMAIN_HALO_WIDTH, std::min(parsedInputStruct->gridSizeX / domainsX, parsedInputStruct->gridSizeY / domainsY) / 2);
+    domains->clear();
+    for(j = 0; j < domainsY; j++)
+    {
+        for(i = 0; i < domainsX; i++)
+        {
+            domain = routingDomain_t();
+            domain.left = (unsigned long long)i * parsedInputStruct->gridSizeX / domainsX;
+            domain.right = (unsigned long long)(i + 1) * parsedInputStruct->gridSizeX / domainsX;
+            domain.top = (unsigned long long)j * parsedInputStruct->gridSizeY / domainsY;
+            domain.bottom = (unsigned long long)(j + 1) * parsedInputStruct->gridSizeY / domainsY;
+            domain.windowLeft = domain.left - std::min(domain.left, halo);
+            domain.windowRight = std::min(domain.right + halo, parsedInputStruct->gridSizeX);
+            domain.windowTop = domain.top - std::min(domain.top, halo);
+            domain.windowBottom = std::min(domain.bottom + halo, parsedInputStruct->gridSizeY);
+            domain.haloPhase = 1 + (i % 2) + 2 * (j % 2);
+            domain.socket = -1;
+            domain.processId = -1;
+            domains->push_back(domain);
+        }
+    }
+}
+
+int AssignDomainNet(std::vector<routingDomain_t> *domains, std::vector<posStruct_t> *netNodes, unsigned int *phase)
+{
+    unsigned int i, j, k;
+    bool inDomain, inHalo;
+
+    // The net goes to the first domain one of its pins is in that also sees the rest of them, a net within the domain of its first pin is routed there
+    for(i = 0; i < netNodes->size(); i++)
+    {
+        for(j = 0; j < domains->size(); j++)
+        {
+            if(!IsInDomain(&(*domains)[j], &(*netNodes)[i], false))
+            {
+                continue;
+            }
+            inDomain = true;
+            inHalo = true;
+            for(k = 0; k < netNodes->size(); k++)
+            {
+                inDomain = inDomain && IsInDomain(&(*domains)[j], &(*netNodes)[k], false);
+                inHalo = inHalo && IsInDomain(&(*domains)[j], &(*netNodes)[k], true);
+            }
+            if(inHalo)
+            {
+                *phase = inDomain ? 0 : (*domains)[j].haloPhase;
+                return j;
+            }
+        }
+    }
+
+    return -1;
+}
+
+bool IsInDomain(routingDomain_t *domain, posStruct_t *pos, bool halo)
+{
+    if(halo)
+    {
+        return pos->posX >= domain->windowLeft && pos->posX < domain->windowRight && pos->posY >= domain->windowTop && pos->posY < domain->windowBottom;
+    }
+    return pos->posX >= domain->left && pos->posX < domain->right && pos->posY >= domain->top && pos->posY < domain->bottom;
+}
+
+bool StartDomainWorker(std::vector<routingDomain_t> *domains, unsigned int domain)
+{
+#ifdef WIN32
+    return false;
+#else
+    unsigned int i;
+    int sockets[2];
+    pid_t processId;
+
+    if(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets) != 0)
+    {
+        return false;
+    }
+    // Don't let the worker print what's still buffered a second time
+    fflush(stdout);
+    processId = fork();
+    if(processId < 0)
+    {
+        close(sockets[0]);
+        close(sockets[1]);
+        return false;
+    }
+    if(processId == 0)
+    {
+        // The worker only keeps its end of its own socket
+        close(sockets[0]);
+        for(i = 0; i < domain; i++)
+        {
+            if((*domains)[i].socket >= 0)
+            {
+                close((*domains)[i].socket);
+            }
+        }
+        DomainWorker(sockets[1]);
+        close(sockets[1]);
+        fflush(stdout);
+        _exit(0);
+    }
+    close(sockets[1]);
+    (*domains)[domain].socket = sockets[0];
+    (*domains)[domain].processId = processId;
+
+    return true;
+#endif
+}
+
+void GetDomainProblem(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, std::vector<routingDomain_t> *domains, std::vector<int> *netDomains, std::vector<unsigned int> *netPhases, unsigned int domain, std::vector<unsigned int> *payload)
+{
+    unsigned int i, j, options;
+    size_t countIndex;
+    const char *key;
+    routingDomain_t *current;
+
+    current = &(*domains)[domain];
+    payload->clear();
+
+    //1. The window, and the domain and halo phase within it
+    payload->push_back(current->windowLeft);
+    payload->push_back(current->windowTop);
+    payload->push_back(current->windowRight - current->windowLeft);
+    payload->push_back(current->windowBottom - current->windowTop);
+    payload->push_back(parsedInputStruct->gridSizeZ);
+    payload->push_back(current->left);
+    payload->push_back(current->top);
+    payload->push_back(current->right);
+    payload->push_back(current->bottom);
+    payload->push_back(current->haloPhase);
+
+    //2. The routing options, the engine goes by its name on the command line
+    key = gridStruct->engine->key;
+    payload->push_back(strlen(key));
+    for(i = 0; key[i] != '\0'; i++)
+    {
+        payload->push_back((unsigned char)key[i]);
+    }
+    options = 0;
+    options |= gridStruct->weighted ? DOMAIN_OPTION_WEIGHTED : 0;
+    options |= gridStruct->ripUp ? DOMAIN_OPTION_RIPUP : 0;
+    options |= gridStruct->useRouteCache ? DOMAIN_OPTION_ROUTE_CACHE : 0;
+    options |= gridStruct->tiledLayout ? DOMAIN_OPTION_TILED : 0;
+    options |= gridStruct->verbose ? DOMAIN_OPTION_VERBOSE : 0;
+    options |= gridStruct->reservePinAccess ? DOMAIN_OPTION_PIN_ACCESS : 0;
+    payload->push_back(options);
+    payload->push_back(gridStruct->retryPolicy);
+    payload->push_back((unsigned int)(gridStruct->expansionCap & 0xFFFFFFFF));
+    payload->push_back((unsigned int)(gridStruct->expansionCap >> 32));
+    payload->push_back((unsigned int)(gridStruct->timeBudget * 1000.0));
+    payload->push_back(gridStruct->seed + domain);
+
+    //3. The obstructions in the window, the pins of the nets other workers route (or that are left for the whole grid) are obstructions to this one
+    countIndex = payload->size();
+    payload->push_back(0);
+    for(i = 0; i < parsedInputStruct->obstructions.size(); i++)
+    {
+        if(parsedInputStruct->obstructions[i].posZ < parsedInputStruct->gridSizeZ && IsInDomain(current, &parsedInputStruct->obstructions[i], true))
+        {
+            PutDomainPos(payload, &parsedInputStruct->obstructions[i]);
+            (*payload)[countIndex]++;
+        }
+    }
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        for(j = 0; j < parsedInputStruct->nodes[i].size() && (*netDomains)[i] != (int)domain; j++)
+        {
+            if(parsedInputStruct->nodes[i][j].posZ < parsedInputStruct->gridSizeZ && IsInDomain(current, &parsedInputStruct->nodes[i][j], true))
+            {
+                PutDomainPos(payload, &parsedInputStruct->nodes[i][j]);
+                (*payload)[countIndex]++;
+            }
+        }
+    }
+
+    //4. The domain's nets and the phase each one is routed in
+    payload->push_back(current->nets.size());
+    for(i = 0; i < current->nets.size(); i++)
+    {
+        payload->push_back(current->nets[i]);
+        payload->push_back((*netPhases)[current->nets[i]]);
+        payload->push_back(parsedInputStruct->nodes[current->nets[i]].size());
+        for(j = 0; j < parsedInputStruct->nodes[current->nets[i]].size(); j++)
+        {
+            PutDomainPos(payload, &parsedInputStruct->nodes[current->nets[i]][j]);
+        }
+    }
+}
+
+void DomainWorker(int socket)
+{
+    unsigned int i, phase, numUpdates;
+    size_t cursor;
+    posStruct_t pos;
+    domainMessage_e type;
+    std::vector<unsigned int> payload;
+    std::vector<unsigned int> results;
+    domainWorker_t *worker = new domainWorker_t();
+
+    //1. Take in the domain, every phase's routing is kept quiet unless we're printing every step
+    if(ReadDomainMessage(socket, &type, &payload) && type == DOMAIN_MSG_PROBLEM && SetDomainProblem(worker, &payload))
+    {
+        if(!worker->options.verbose)
+        {
+            freopen("/dev/null", "w", stdout);
+        }
+
+        //2. Route every phase we're sent, after blocking the cells the other workers routed in our window, until we're told we're done
+        while(ReadDomainMessage(socket, &type, &payload) && type == DOMAIN_MSG_ROUTE)
+        {
+            cursor = 0;
+            if(!TakeDomainValue(&payload, &cursor, &phase) || !TakeDomainValue(&payload, &cursor, &numUpdates))
+            {
+                break;
+            }
+            for(i = 0; i < numUpdates && TakeDomainPos(&payload, &cursor, &pos); i++)
+            {
+                if(pos.posX >= worker->origin.posX && pos.posX - worker->origin.posX < worker->window.gridSizeX &&
+                    pos.posY >= worker->origin.posY && pos.posY - worker->origin.posY < worker->window.gridSizeY && pos.posZ < worker->window.gridSizeZ)
+                {
+                    pos.posX -= worker->origin.posX;
+                    pos.posY -= worker->origin.posY;
+                    worker->blocked.push_back(pos);
+                }
+            }
+            RouteDomainPhase(worker, phase, &results);
+            if(!WriteDomainMessage(socket, DOMAIN_MSG_ROUTED, &results))
+            {
+                break;
+            }
+        }
+    }
+
+    delete worker;
+}
+
+bool SetDomainProblem(domainWorker_t *worker, std::vector<unsigned int> *payload)
+{
+    unsigned int i, j, numValues, value;
+    unsigned long long capHigh;
+    size_t cursor;
+    posStruct_t pos;
+    std::string key;
+    std::vector<posStruct_t> pins;
+
+    //1. The window, and the domain and halo phase within it
+    cursor = 0;
+    if(!TakeDomainValue(payload, &cursor, &worker->origin.posX) || !TakeDomainValue(payload, &cursor, &worker->origin.posY) ||
+        !TakeDomainValue(payload, &cursor, &worker->window.gridSizeX) || !TakeDomainValue(payload, &cursor, &worker->window.gridSizeY) ||
+        !TakeDomainValue(payload, &cursor, &worker->window.gridSizeZ) ||
+        !TakeDomainValue(payload, &cursor, &worker->left) || !TakeDomainValue(payload, &cursor, &worker->top) ||
+        !TakeDomainValue(payload, &cursor, &worker->right) || !TakeDomainValue(payload, &cursor, &worker->bottom) ||
+        !TakeDomainValue(payload, &cursor, &worker->haloPhase))
+    {
+        return false;
+    }
+    worker->origin.posZ = 0;
+    worker->left -= std::min(worker->left, worker->origin.posX);
+    worker->right -= std::min(worker->right, worker->origin.posX);
+    worker->top -= std::min(worker->top, worker->origin.posY);
+    worker->bottom -= std::min(worker->bottom, worker->origin.posY);
+
+    //2. The routing options
+    if(!TakeDomainValue(payload, &cursor, &numValues))
+    {
+        return false;
+    }
+    for(i = 0; i < numValues; i++)
+    {
+        if(!TakeDomainValue(payload, &cursor, &value))
+        {
+            return false;
+        }
+        key.push_back((char)value);
+    }
+    worker->options.engine = FindEngine(key.c_str());
+    if(worker->options.engine == NULL || !TakeDomainValue(payload, &cursor, &value))
+    {
+        return false;
+    }
+    worker->options.weighted = (value & DOMAIN_OPTION_WEIGHTED) != 0;
+    worker->options.ripUp = (value & DOMAIN_OPTION_RIPUP) != 0;
+    worker->options.useRouteCache = (value & DOMAIN_OPTION_ROUTE_CACHE) != 0;
+    worker->options.tiledLayout = (value & DOMAIN_OPTION_TILED) != 0;
+    worker->options.verbose = (value & DOMAIN_OPTION_VERBOSE) != 0;
+    worker->options.reservePinAccess = (value & DOMAIN_OPTION_PIN_ACCESS) != 0;
+    if(!TakeDomainValue(payload, &cursor, &value) || value > RETRY_FREQUENT)
+    {
+        return false;
+    }
+    worker->options.retryPolicy = (retryPolicy_e)value;
+    if(!TakeDomainValue(payload, &cursor, &value) || !TakeDomainValue(payload, &cursor, &numValues))
+    {
+        return false;
+    }
+    capHigh = numValues;
+    worker->options.expansionCap = (capHigh << 32) | value;
+    if(!TakeDomainValue(payload, &cursor, &value))
+    {
+        return false;
+    }
+    worker->options.timeBudget = value / 1000.0;
+    if(!TakeDomainValue(payload, &cursor, &worker->options.seed))
+    {
+        return false;
+    }
+
+    //3. The obstructions, in window coordinates
+    if(!TakeDomainValue(payload, &cursor, &numValues))
+    {
+        return false;
+    }
+    for(i = 0; i < numValues; i++)
+    {
+        if(!TakeDomainPos(payload, &cursor, &pos) || pos.posX < worker->origin.posX || pos.posY < worker->origin.posY)
+        {
+            return false;
+        }
+        pos.posX -= worker->origin.posX;
+        pos.posY -= worker->origin.posY;
+        worker->window.obstructions.push_back(pos);
+    }
+
+    //4. The nets, in window coordinates
+    if(!TakeDomainValue(payload, &cursor, &numValues))
+    {
+        return false;
+    }
+    for(i = 0; i < numValues; i++)
+    {
+        worker->netIds.push_back(0);
+        worker->netPhases.push_back(0);
+        worker->netRouted.push_back(false);
+        if(!TakeDomainValue(payload, &cursor, &worker->netIds.back()) || !TakeDomainValue(payload, &cursor, &worker->netPhases.back()) ||
+            !TakeDomainValue(payload, &cursor, &value))
+        {
+            return false;
+        }
+        pins.clear();
+        for(j = 0; j < value; j++)
+        {
+            if(!TakeDomainPos(payload, &cursor, &pos) || pos.posX < worker->origin.posX || pos.posY < worker->origin.posY ||
+                pos.posX - worker->origin.posX >= worker->window.gridSizeX || pos.posY - worker->origin.posY >= worker->window.gridSizeY)
+            {
+                return false;
+            }
+            pos.posX -= worker->origin.posX;
+            pos.posY -= worker->origin.posY;
+            pins.push_back(pos);
+        }
+        if(pins.empty())
+        {
+            return false;
+        }
+        worker->netPins.push_back(pins);
+    }
+
+    return true;
+}
+
+void RouteDomainPhase(domainWorker_t *worker, unsigned int phase, std::vector<unsigned int> *results)
+{
+    unsigned int i, j, x, y, z;
+    int net;
+    parsedInputStruct_t phaseInput = parsedInputStruct_t();
+    gridStruct_t phaseGrid = gridStruct_t();
+    std::vector<unsigned int> phaseNets;
+    std::vector<bool> phaseRouted;
+    std::vector<int> netOwners;
+    std::vector<std::vector<posStruct_t>> wires;
+    std::vector<posStruct_t> *pins;
+    cellStruct_t *currentCell;
+    posStruct_t pos;
+
+    results->assign(1, 0);
+
+    //1. The phase's nets are routed, the pins of the other nets and every cell routed so far are obstructions
+    phaseInput.gridSizeX = worker->window.gridSizeX;
+    phaseInput.gridSizeY = worker->window.gridSizeY;
+    phaseInput.gridSizeZ = worker->window.gridSizeZ;
+    phaseInput.obstructions = worker->window.obstructions;
+    phaseInput.obstructions.insert(phaseInput.obstructions.end(), worker->blocked.begin(), worker->blocked.end());
+    for(i = 0; i < worker->netIds.size(); i++)
+    {
+        if(!worker->netRouted[i] && worker->netPhases[i] == phase)
+        {
+            phaseNets.push_back(i);
+            phaseInput.nodes.push_back(worker->netPins[i]);
+        }
+        else
+        {
+            phaseInput.obstructions.insert(phaseInput.obstructions.end(), worker->netPins[i].begin(), worker->netPins[i].end());
+        }
+    }
+    if(phaseNets.empty())
+    {
+        return;
+    }
+    // Every domain routes its own nets at the same time, so none of them may route into its halo yet
+    for(z = 0; z < phaseInput.gridSizeZ && phase == 0; z++)
+    {
+        for(y = 0; y < phaseInput.gridSizeY; y++)
+        {
+            for(x = 0; x < phaseInput.gridSizeX; x++)
+            {
+                if(x < worker->left || x >= worker->right || y < worker->top || y >= worker->bottom)
+                {
+                    pos.posX = x;
+                    pos.posY = y;
+                    pos.posZ = z;
+                    phaseInput.obstructions.push_back(pos);
+                }
+            }
+        }
+    }
+
+    //2. Route the window like any other grid
+    phaseGrid.engine = worker->options.engine;
+    phaseGrid.weighted = worker->options.weighted;
+    phaseGrid.ripUp = worker->options.ripUp;
+    phaseGrid.useRouteCache = worker->options.useRouteCache;
+    phaseGrid.tiledLayout = worker->options.tiledLayout;
+    phaseGrid.verbose = worker->options.verbose;
+    phaseGrid.retryPolicy = worker->options.retryPolicy;
+    phaseGrid.expansionCap = worker->options.expansionCap;
+    phaseGrid.timeBudget = worker->options.timeBudget;
+    phaseGrid.reservePinAccess = worker->options.reservePinAccess;
+    phaseGrid.seed = worker->options.seed + phase;
+    phaseGrid.rng.seed(phaseGrid.seed);
+    // A window that can't be built routes nothing, its nets are left for the whole grid
+    if(!RouterInit(&phaseInput, &phaseGrid))
+    {
+        return;
+    }
+    RouterRun(&phaseInput, &phaseGrid, STEP_COMPLETE);
+
+    //3. Find the nets that got routed from their pins, the grid may be the best one of an earlier attempt with the nets in another order
+    phaseRouted.assign(phaseNets.size(), false);
+    netOwners.assign(phaseInput.nodes.size(), -1);
+    for(i = 0; i < phaseNets.size(); i++)
+    {
+        pins = &worker->netPins[phaseNets[i]];
+        net = GetCellNet(GetCell(&phaseGrid, (*pins)[0].posX, (*pins)[0].posY, (*pins)[0].posZ));
+        phaseRouted[i] = net >= 0 && (unsigned int)net < netOwners.size();
+        for(j = 0; j < pins->size() && phaseRouted[i]; j++)
+        {
+            currentCell = GetCell(&phaseGrid, (*pins)[j].posX, (*pins)[j].posY, (*pins)[j].posZ);
+            phaseRouted[i] = GetCellNet(currentCell) == net && currentCell->currentCellProp != CELL_NET_SINK_UNCONN;
+        }
+        if(phaseRouted[i])
+        {
+            netOwners[net] = i;
+        }
+    }
+
+    //4. Gather the routed nets' wires
+    wires.resize(phaseNets.size());
+    for(z = 0; z < phaseInput.gridSizeZ; z++)
+    {
+        for(y = 0; y < phaseInput.gridSizeY; y++)
+        {
+            for(x = 0; x < phaseInput.gridSizeX; x++)
+            {
+                currentCell = GetCell(&phaseGrid, x, y, z);
+                if(currentCell->currentCellProp == CELL_NET_WIRE_CONN && GetCellNet(currentCell) >= 0 &&
+                    (unsigned int)GetCellNet(currentCell) < netOwners.size() && netOwners[GetCellNet(currentCell)] >= 0)
+                {
+                    pos.posX = x;
+                    pos.posY = y;
+                    pos.posZ = z;
+                    wires[netOwners[GetCellNet(currentCell)]].push_back(pos);
+                }
+            }
+        }
+    }
+
+    //5. Report them in the whole grid's coordinates and keep them clear in the phases to come
+    for(i = 0; i < phaseNets.size(); i++)
+    {
+        if(!phaseRouted[i])
+        {
+            // A net that couldn't be routed within the domain gets another go with the halo in reach
+            if(phase == 0)
+            {
+                worker->netPhases[phaseNets[i]] = worker->haloPhase;
+            }
+            continue;
+        }
+        worker->netRouted[phaseNets[i]] = true;
+        (*results)[0]++;
+        results->push_back(worker->netIds[phaseNets[i]]);
+        results->push_back(wires[i].size());
+        for(j = 0; j < wires[i].size(); j++)
+        {
+            worker->blocked.push_back(wires[i][j]);
+            pos = wires[i][j];
+            pos.posX += worker->origin.posX;
+            pos.posY += worker->origin.posY;
+            PutDomainPos(results, &pos);
+        }
+    }
+}
+
+bool TakeDomainValue(std::vector<unsigned int> *payload, size_t *cursor, unsigned int *value)
+{
+    if(*cursor >= payload->size())
+    {
+        return false;
+    }
+    *value = (*payload)[(*cursor)++];
+    return true;
+}
+
+bool TakeDomainPos(std::vector<unsigned int> *payload, size_t *cursor, posStruct_t *pos)
+{
+    return TakeDomainValue(payload, cursor, &pos->posX) && TakeDomainValue(payload, cursor, &pos->posY) && TakeDomainValue(payload, cursor, &pos->posZ);
+}
+
+void PutDomainPos(std::vector<unsigned int> *payload, posStruct_t *pos)
+{
+    payload->push_back(pos->posX);
+    payload->push_back(pos->posY);
+    payload->push_back(pos->posZ);
+}
+
+bool WriteDomainMessage(int socket, domainMessage_e type, std::vector<unsigned int> *payload)
+{
+#ifdef WIN32
+    return false;
+#else
+    size_t i, size;
+    ssize_t written;
+    domainMessageHeader_t header;
+    const char *data;
+
+    // The header, then the payload, a socket may take either in several goes
+    header.type = type;
+    header.length = payload->size();
+    for(i = 0; i < 2; i++)
+    {
+        data = (i == 0) ? (const char*)&header : (const char*)payload->data();
+        size = (i == 0) ? sizeof(header) : payload->size() * sizeof(unsigned int);
+        while(size > 0)
+        {
+            written = send(socket, data, size, MSG_NOSIGNAL);
+            if(written <= 0)
+            {
+                return false;
+            }
+            data += written;
+            size -= written;
+        }
+    }
+
+    return true;
+#endif
+}
+
+bool ReadDomainMessage(int socket, domainMessage_e *type, std::vector<unsigned int> *payload)
+{
+#ifdef WIN32
+    return false;
+#else
+    size_t i, size;
+    ssize_t received;
+    domainMessageHeader_t header;
+    char *data;
+
+    for(i = 0; i < 2; i++)
+    {
+        if(i == 1)
+        {
+            payload->resize(header.length);
+        }
+        data = (i == 0) ? (char*)&header : (char*)payload->data();
+        size = (i == 0) ? sizeof(header) : payload->size() * sizeof(unsigned int);
+        while(size > 0)
+        {
+            received = recv(socket, data, size, 0);
+            if(received <= 0)
+            {
+                return false;
+            }
+            data += received;
+            size -= received;
+        }
+    }
+    *type = (domainMessage_e)header.type;
+
+    return true;
+#endif
+}
@@ -0,0 +1,391 @@
+#define _CRT_SECURE_NO_WARNINGS //  Disable unsafe warnings, to enable use of sprintf within VS2017
+
+#include <vector>
+
+#include "RouterCore.h"
+
+// Lee Moore expands a wavefront from the net's routed cells until it reaches a sink, then walks back along it
+const routerEngine_t leeMooreEngine =
+{
+    "lee",
+    "LeeMoore",
+    LEE_MOORE_ROUTING_RETRIES,
+    NULL,
+    NULL,
+    LeeMooreBeginNet,
+    LeeMooreStep
+};
+
+void LeeMooreBeginNet(parsedInputStruct_t *, gridStruct_t *gridStruct)
+{
+    // Start expanding from the source
+    gridStruct->currentExpansion = 0;
+    gridStruct->currentRoutingState = STATE_EXPANSION;
+}
+
+void LeeMooreStep(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    bool doneExpansion;
+    bool doneWalkback;
+    unsigned int x, y, i, dir;
+    cellStruct_t* currentCell;
+    cellStruct_t *neighbours[DIR_NUM];
+    posStruct_t pos;
+    std::vector<cellStruct_t*> *currentExpansionList;
+
+    // Execute routing step based on current state
+    switch(gridStruct->currentRoutingState)
+    {
+        case STATE_EXPANSION:
+            doneExpansion = false;
+            // Push a new expansion list for this layer (weighted mode only creates buckets as cells are pushed into them)
+            if(!gridStruct->weighted || gridStruct->expansionList.empty())
+            {
+                currentExpansionList = new std::vector<cellStruct_t*>;
+                gridStruct->expansionList.push_back(*currentExpansionList);
+            }
+
+            // If we are at our first expansion and not our first node, give the last route cells an expansion of 0 and add them to the expansion list
+            // (If we're on the first node, then we still have nodes - 1 to route, anything less and we're on subsequent routes)
+            if(gridStruct->currentExpansion == 0 &&
+                gridStruct->netRoutedNodes[gridStruct->currentNet] < (parsedInputStruct->nodes[gridStruct->currentNet].size() - 1))
+            {
+                // Add the last route to the expansion list and make them all an expansion of 0
+                for(i = 0; i < gridStruct->lastRoute.size(); i++)
+                {
+                    SetCellLabel(gridStruct, gridStruct->lastRoute[i], 0);
+                    gridStruct->lastRoute[i]->prevDir = DIR_NUM;
+                    gridStruct->expansionList[gridStruct->currentExpansion].push_back(gridStruct->lastRoute[i]);
+                }
+            }
+            // If we are at our first expansion and our first node, give the source the expansion of 0 and add it to the list
+            else if(gridStruct->currentExpansion == 0)
+            {
+                // First node is the source
+                x = parsedInputStruct->nodes[gridStruct->currentNet][0].posX;
+                y = parsedInputStruct->nodes[gridStruct->currentNet][0].posY;
+                currentCell = GetCell(gridStruct, x, y, parsedInputStruct->nodes[gridStruct->currentNet][0].posZ);
+                gridStruct->expansionList[gridStruct->currentExpansion].push_back(currentCell);
+                // Give our source an expansion of 0
+                SetCellLabel(gridStruct, currentCell, 0);
+                currentCell->prevDir = DIR_NUM;
+            }
+            // In weighted mode, each step drains the next cost bucket instead of a unit layer
+            else if(gridStruct->weighted)
+            {
+                doneExpansion = ExpandBucket(parsedInputStruct, gridStruct);
+            }
+            // We've started expanding already
+            else
+            {
+                if(gridStruct->verbose)
+                {
+                    printf("Cells to visit for expansion: %d\n", gridStruct->expansionList[gridStruct->currentExpansion - 1].size());
+                }
+                // Check if we can still expand, if not, we failed this route
+                if(gridStruct->expansionList[gridStruct->currentExpansion - 1].size() == 0)
+                {
+                    // Reset our expansion
+                    ResetCellExpansion(gridStruct);
+                    FailNet(parsedInputStruct, gridStruct);
+                    doneExpansion = true;
+                    break;
+                }
+                // For each cell in the previous layer's expansion list, expand into the new (current) expansion
+                for(i = 0; i < gridStruct->expansionList[gridStruct->currentExpansion - 1].size(); i++)
+                {
+                    // Get a pointer to the current cell
+                    currentCell = gridStruct->expansionList[gridStruct->currentExpansion - 1][i];
+                    GetNeighbours(gridStruct, currentCell, neighbours);
+
+                    // For each cardinal direction
+                    for(dir = DIR_NORTH; dir < DIR_NUM; dir++)
+                    {
+                        // Make sure we have a cell to look at
+                        if(neighbours[dir] == NULL)
+                        {
+                            continue;
+                        }
+                        // Check if the cell is an unconnected sink and it's our net
+                        else if(neighbours[dir]->currentCellProp == CELL_NET_SINK_UNCONN &&
+                            GetCellNet(neighbours[dir]) == gridStruct->currentNet)
+                        {
+                            // We've found a sink! Keep a reference to it
+                            gridStruct->lastCell = neighbours[dir];
+                            // Time to walk back from it now
+                            gridStruct->currentRoutingState = STATE_WALKBACK;
+                            // No more expansion, lets get out of here
+                            doneExpansion = true;
+                            break;
+                        }
+                        // Check if the cell is routeable (it's empty and isn't part of a routing layer
+                        else if(neighbours[dir]->currentCellProp == CELL_EMPTY && GetCellLabel(gridStruct, neighbours[dir]) == -1 &&
+                            !IsReservedCell(gridStruct, neighbours[dir]))
+                        {
+                            // We found a routeable cell! Mark it for the current expansion
+                            SetCellLabel(gridStruct, neighbours[dir], gridStruct->currentExpansion);
+                            gridStruct->currentTelemetry.cellsExpanded++;
+                            // Add a reference to it for the current expansion list
+                            gridStruct->expansionList[gridStruct->currentExpansion].push_back(neighbours[dir]);
+                        }
+                    }
+
+                    // Break out of outer loop since we've found our sink and we're done expansion
+                    if(doneExpansion)
+                    {
+                        break;
+                    }
+                }
+            }
+            // Go to the next expansion layer if we're not done expanding
+            if(!doneExpansion)
+            {
+                // Keep track of how deep and wide the net's expansion gets (weighted buckets are tracked as they're drained)
+                gridStruct->currentTelemetry.expansionLayers++;
+                if(!gridStruct->weighted && gridStruct->expansionList[gridStruct->currentExpansion].size() > gridStruct->currentTelemetry.frontierPeak)
+                {
+                    gridStruct->currentTelemetry.frontierPeak = gridStruct->expansionList[gridStruct->currentExpansion].size();
+                }
+                gridStruct->currentExpansion++;
+            }
+            break;
+        case STATE_WALKBACK:
+            doneWalkback = false;
+
+            // At this point we have found a sink to connect to, now we need to walk back
+            // The lastcell pointer will have the last cell to walk back from
+
+            // Get a pointer to the last cell
+            currentCell = gridStruct->lastCell;
+            if(gridStruct->verbose)
+            {
+                GetCellPos(gridStruct, currentCell, &pos);
+                printf("Walking back net %d, current cell is %d, %d, %d\n", gridStruct->currentNet, pos.posX, pos.posY, pos.posZ);
+            }
+
+            // Add the cell to our last route list
+            gridStruct->lastRoute.push_back(currentCell);
+            gridStruct->currentTelemetry.walkbackLength++;
+            GetNeighbours(gridStruct, currentCell, neighbours);
+
+            // For each cardinal direction
+            for(dir = DIR_NORTH; dir < DIR_NUM; dir++)
+            {
+                // In weighted mode only follow the direction we were expanded from
+                if(gridStruct->weighted && dir != currentCell->prevDir)
+                {
+                    continue;
+                }
+                // Make sure we have a cell to look at
+                if(neighbours[dir] == NULL)
+                {
+                    continue;
+                }
+                // Check if we've found our original net
+                else if(GetCellNet(neighbours[dir]) == gridStruct->currentNet && !(neighbours[dir]->currentCellProp == CELL_NET_SINK_UNCONN || neighbours[dir]->currentCellProp == CELL_NET_WIRE_UNCONN))
+                {
+                    // Found our net!
+                    if(gridStruct->verbose)
+                    {
+                        printf("Found our net!\n");
+                    }
+                    // Also add it to our last route
+                    gridStruct->lastRoute.push_back(neighbours[dir]);
+                    // Time to cleanup
+                    // Go into our last route, and change unconnected sinks and wires to connected
+                    for(i = 0; i < gridStruct->lastRoute.size(); i++)
+                    {
+                        switch(gridStruct->lastRoute[i]->currentCellProp)
+                        {
+                            case CELL_NET_SINK_UNCONN:
+                                SetCellProp(gridStruct, gridStruct->lastRoute[i], CELL_NET_SINK_CONN);
+                                break;
+                            case CELL_NET_WIRE_UNCONN:
+                                SetCellProp(gridStruct, gridStruct->lastRoute[i], CELL_NET_WIRE_CONN);
+                                break;
+                            default:
+                                break;
+                        }
+                    }
+                    // Go into our expansion list and revert their numbers to -1
+                    ResetCellExpansion(gridStruct);
+                    // Clear out the expansion list
+                    gridStruct->expansionList.clear();
+                    // Go back to expansion of 0
+                    gridStruct->currentExpansion = 0;
+                    // Done our walkback
+                    doneWalkback = true;
+                    // Decrement our nodes to route
+                    gridStruct->netRoutedNodes[gridStruct->currentNet]--;
+                    // If we have nodes left to route, go back to expansion
+                    if(gridStruct->netRoutedNodes[gridStruct->currentNet])
+                    {
+                        gridStruct->currentRoutingState = STATE_EXPANSION;
+                    }
+                    // Otherwise we are done with this net
+                    else
+                    {
+                        FinishNet(parsedInputStruct, gridStruct);
+                    }
+                    break;
+                }
+                // Check if the cell's number is one less than the current expansion (or it's our predecessor in weighted mode)
+                else if(gridStruct->weighted || GetCellLabel(gridStruct, neighbours[dir]) == gridStruct->currentExpansion - 1)
+                {
+                    // We've found a route back!
+                    // Take note of our cell
+                    gridStruct->lastCell = neighbours[dir];
+                    // Route the cell
+                    SetCellNet(gridStruct, neighbours[dir], gridStruct->currentNet);
+                    SetCellProp(gridStruct, neighbours[dir], CELL_NET_WIRE_UNCONN);
+                    // Go back an expansion
+                    gridStruct->currentExpansion--;
+                    // We're done, go to next walkback cell
+                    break;
+                }
+            }
+
+            break;
+        default:
+            break;
+    }
+}
+
+bool ExpandBucket(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, dir, bucket, newCost;
+    cellStruct_t *currentCell, *nextCell;
+    cellStruct_t *neighbours[DIR_NUM];
+    posStruct_t pos;
+
+    // The bucket to drain holds every cell whose cheapest known cost is one less than the current expansion
+    bucket = gridStruct->currentExpansion - 1;
+
+    // Buckets are only created when a cell is pushed into them, so running past the last one means nothing is left to expand
+    if(bucket >= gridStruct->expansionList.size())
+    {
+        // Reset our expansion
+        ResetCellExpansion(gridStruct);
+        FailNet(parsedInputStruct, gridStruct);
+        return true;
+    }
+
+    if(gridStruct->verbose)
+    {
+        printf("Cells to visit for bucket %d: %d\n", bucket, (int)gridStruct->expansionList[bucket].size());
+    }
+    if(gridStruct->expansionList[bucket].size() > gridStruct->currentTelemetry.frontierPeak)
+    {
+        gridStruct->currentTelemetry.frontierPeak = gridStruct->expansionList[bucket].size();
+    }
+
+    // Index the bucket every time since pushing into later buckets can reallocate the list
+    for(i = 0; i < gridStruct->expansionList[bucket].size(); i++)
+    {
+        currentCell = gridStruct->expansionList[bucket][i];
+
+        // Skip stale entries for cells that were later reached more cheaply
+        if(GetCellLabel(gridStruct, currentCell) != (int)bucket)
+        {
+            continue;
+        }
+        // Nothing in a later bucket can reach the sink more cheaply, so walk back from it once its own bucket comes up
+        if(currentCell->currentCellProp == CELL_NET_SINK_UNCONN)
+        {
+            gridStruct->lastCell = currentCell;
+            gridStruct->currentRoutingState = STATE_WALKBACK;
+            return true;
+        }
+
+        GetCellPos(gridStruct, currentCell, &pos);
+        GetNeighbours(gridStruct, currentCell, neighbours);
+
+        // For each cardinal direction
+        for(dir = DIR_NORTH; dir < DIR_NUM; dir++)
+        {
+            nextCell = neighbours[dir];
+
+            // Make sure we have a cell to look at
+            if(nextCell == NULL)
+            {
+                continue;
+            }
+            // Check if the cell is routeable, or an unconnected sink of our net (relaxed like any other cell so we only walk back along the cheapest way in)
+            else if((nextCell->currentCellProp == CELL_EMPTY && !IsReservedCell(gridStruct, nextCell)) ||
+                (nextCell->currentCellProp == CELL_NET_SINK_UNCONN && GetCellNet(nextCell) == (int)gridStruct->currentNet))
+            {
+                newCost = bucket + GetStepCost(gridStruct, currentCell, nextCell, dir, pos.posZ);
+                // Only relax the cell if this is the first or a cheaper way to reach it
+                if(GetCellLabel(gridStruct, nextCell) == -1 || (int)newCost < GetCellLabel(gridStruct, nextCell))
+                {
+                    SetCellLabel(gridStruct, nextCell, newCost);
+                    nextCell->prevDir = GetOppositeDirection(dir);
+                    gridStruct->currentTelemetry.cellsExpanded++;
+                    // Make sure the bucket for this cost exists
+                    if(gridStruct->expansionList.size() <= newCost)
+                    {
+                        gridStruct->expansionList.resize(newCost + 1);
+                    }
+                    gridStruct->expansionList[newCost].push_back(nextCell);
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+int GetStepCost(gridStruct_t *gridStruct, cellStruct_t *cell, cellStruct_t *nextCell, unsigned int dir, unsigned int layer)
+{
+    int cost;
+    unsigned int side;
+    cellStruct_t *sideCell;
+
+    // Pay for the cell we are stepping into
+    cost = nextCell->cost;
+
+    // Pay for crowding in next to the wires other nets have routed so far
+    for(side = DIR_NORTH; side < DIR_UP; side++)
+    {
+        sideCell = GetNeighbour(gridStruct, nextCell, side);
+        if(sideCell != NULL && (sideCell->currentCellProp == CELL_NET_WIRE_CONN || sideCell->currentCellProp == CELL_NET_WIRE_UNCONN) &&
+            GetCellNet(sideCell) != (int)gridStruct->currentNet)
+        {
+            cost += WEIGHT_CONGESTION;
+        }
+    }
+
+    // Vias pay their own cost instead of bend and direction costs
+    if(dir == DIR_UP || dir == DIR_DOWN)
+    {
+        return cost + WEIGHT_VIA;
+    }
+
+    // Pay for a bend if we don't continue in the direction we came in from (arriving through a via isn't a bend)
+    // Cells only keep the direction of their cheapest way in, so a dearer way in that would save a bend later isn't searched and bends are priced approximately
+    if(cell->prevDir < DIR_UP && dir != GetOppositeDirection(cell->prevDir))
+    {
+        cost += WEIGHT_BEND;
+    }
+
+    // Pay for going against the layer's preferred direction
+    switch(gridStruct->layerDirections[layer])
+    {
+        case PREF_DIR_HORIZONTAL:
+            if(dir == DIR_NORTH || dir == DIR_SOUTH)
+            {
+                cost += WEIGHT_WRONG_WAY;
+            }
+            break;
+        case PREF_DIR_VERTICAL:
+            if(dir == DIR_EAST || dir == DIR_WEST)
+            {
+                cost += WEIGHT_WRONG_WAY;
+            }
+            break;
+        default:
+            break;
+    }
+
+    return cost;
+}
@@ -0,0 +1,442 @@
+#define _CRT_SECURE_NO_WARNINGS //  Disable unsafe warnings, to enable use of sprintf within VS2017
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+#include "RouterCore.h"
+
+// Line probing heads straight for the next pin and only expands around what it runs into, cheap but it can miss routes Lee Moore finds
+const routerEngine_t lineProbeEngine =
+{
+    "probe",
+    "LineProbe",
+    LINE_PROBE_ROUTING_RETRIES,
+    NULL,
+    LineProbeInit,
+    LineProbeBeginNet,
+    LineProbeStep
+};
+
+// Racing probes every net first and only pays for Lee Moore on the nets probing gives up on
+const routerEngine_t raceEngine =
+{
+    "race",
+    "Race",
+    LEE_MOORE_ROUTING_RETRIES,
+    &leeMooreEngine,
+    LineProbeInit,
+    LineProbeBeginNet,
+    LineProbeStep
+};
+
+void LineProbeInit(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i;
+    // Shuffle the node order
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        std::shuffle(parsedInputStruct->nodes[i].begin(), parsedInputStruct->nodes[i].end(), gridStruct->rng);
+    }
+}
+
+void LineProbeBeginNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, x0, y0;
+
+    // Populate the node list
+    gridStruct->currentNodes.clear();
+    gridStruct->currentEdges.clear();
+    for(i = 0; i < parsedInputStruct->nodes[gridStruct->currentNet].size(); i++)
+    {
+        x0 = parsedInputStruct->nodes[gridStruct->currentNet][i].posX;
+        y0 = parsedInputStruct->nodes[gridStruct->currentNet][i].posY;
+
+        gridStruct->currentNodes.push_back(GetCell(gridStruct, x0, y0, parsedInputStruct->nodes[gridStruct->currentNet][i].posZ));
+    }
+
+    gridStruct->currentNodePointer = NULL;
+    gridStruct->nextNodePointer = NULL;
+    gridStruct->directionIndex = DIR_IDX_NUM;
+    gridStruct->currentExpansion = 0;
+    gridStruct->currentRoutingState = STATE_SEEK;
+}
+
+void LineProbeStep(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    bool doneSeek;
+    bool allRouted;
+
+    unsigned int i;
+    unsigned int distanceDelta[DIR_IDX_NUM];
+    unsigned int smallestDistance;
+    unsigned int currentDistance;
+
+    cellStruct_t* currentCell;
+    cellStruct_t* nextCell;
+    cardinalDir_e currentDirection;
+    std::vector<cellStruct_t*> detour;
+
+    // Execute routing step based on current state
+    switch(gridStruct->currentRoutingState)
+    {
+        case STATE_SEEK:
+            doneSeek = false;
+
+            // If we don't have a source and target
+            if(gridStruct->currentNodePointer == NULL && gridStruct->nextNodePointer == NULL)
+            {
+                // Go through the node list and find the first unconnected node, this will be the first target
+                for(i = 0; i < gridStruct->currentNodes.size(); i++)
+                {
+                    if(gridStruct->currentNodes[i]->currentCellProp == CELL_NET_SINK_UNCONN)
+                    {
+                        gridStruct->nextNodePointer = gridStruct->currentNodes[i];
+                    }
+                }
+                // Now find the closest node to our target
+                // Start off with an absurdly large distance
+                smallestDistance = 0xDEADBEEF;
+                for(i = 0; i < gridStruct->currentNodes.size(); i++)
+                {
+                    // Only route from nodes that are already connected to the source, this will prevent disconnected nets
+                    if(gridStruct->currentNodes[i]->currentCellProp == CELL_NET_SINK_UNCONN)
+                    {
+                        continue;
+                    }
+                    // Take note of how long each direction is
+                    GetDistanceDelta(gridStruct, gridStruct->currentNodes[i], gridStruct->nextNodePointer, distanceDelta);
+                    // Compare Manhattan distances
+                    currentDistance = distanceDelta[DIR_IDX_EW_X] + distanceDelta[DIR_IDX_NS_Y] + distanceDelta[DIR_IDX_UD_Z];
+                    // If it's less than the current smallest and not the same node
+                    if(currentDistance < smallestDistance && currentDistance != 0)
+                    {
+                        // It's our new source
+                        smallestDistance = currentDistance;
+                        gridStruct->currentNodePointer = gridStruct->currentNodes[i];
+                    }
+                }
+            }
+
+            // Fresh node, let's get started
+            if(gridStruct->directionIndex == DIR_IDX_NUM)
+            {
+                // No direction yet, determine direction of next node
+                SetSeekDirection(gridStruct->currentNodePointer, gridStruct);
+
+                // Seek out from source
+                gridStruct->lastRoute.push_back(gridStruct->currentNodePointer);
+            }
+
+            // Grab our current cell
+            currentCell = gridStruct->lastRoute.back();
+            // Grab our current direction
+            currentDirection = gridStruct->nextNodeDir[gridStruct->directionIndex];
+            nextCell = GetNeighbour(gridStruct, currentCell, currentDirection);
+ 
+            // Seek in the direction
+            // Empty cell, hop on in!
+            if(nextCell != NULL && nextCell->currentCellProp == CELL_EMPTY && !IsReservedCell(gridStruct, nextCell))
+            {
+                // Append to last route
+                gridStruct->lastRoute.push_back(nextCell);
+
+                // Update direction
+                GetDirection(gridStruct->lastRoute.back(), gridStruct->nextNodePointer, gridStruct);
+
+                // Change cell properties
+                SetCellNet(gridStruct, gridStruct->lastRoute.back(), gridStruct->currentNet);
+                SetCellProp(gridStruct, gridStruct->lastRoute.back(), CELL_NET_WIRE_CONN);
+
+                // Do we need to change direction?
+                GetDistanceDelta(gridStruct, gridStruct->lastRoute.back(), gridStruct->nextNodePointer, distanceDelta);
+                if(distanceDelta[DIR_IDX_EW_X] == 0 && distanceDelta[DIR_IDX_NS_Y] == 0)
+                {
+                    // We're right above or below the node, switch layers
+                    gridStruct->directionIndex = DIR_IDX_UD_Z;
+                }
+                else if(distanceDelta[DIR_IDX_EW_X] == 0)
+                {
+                    // We've closed in our X, switch to Y
+                    gridStruct->directionIndex = DIR_IDX_NS_Y;
+                }
+                else if(distanceDelta[DIR_IDX_NS_Y] == 0)
+                {
+                    // We've closed in on our Y, switch to X
+                    gridStruct->directionIndex = DIR_IDX_EW_X;
+                }
+            }
+            // Check if we've reached our destination
+            else if(nextCell != NULL && nextCell->currentCellProp == CELL_NET_SINK_UNCONN && GetCellNet(nextCell) == gridStruct->currentNet)
+            {
+                if(gridStruct->verbose)
+                {
+                    printf("Found unconnected node!\n");
+                }
+
+                // Append to last route
+                gridStruct->lastRoute.push_back(nextCell);
+
+                // Change cell properties
+                SetCellProp(gridStruct, gridStruct->lastRoute.back(), CELL_NET_SINK_CONN);
+
+                // Add the edge to our current edge list
+                gridStruct->currentEdges.push_back(std::make_pair(gridStruct->currentNodePointer, gridStruct->nextNodePointer));
+
+                // Next node!
+                gridStruct->currentNodePointer = NULL;
+                gridStruct->nextNodePointer = NULL;
+                gridStruct->netRoutedNodes[gridStruct->currentNet]--;
+                gridStruct->directionIndex = DIR_IDX_NUM;
+
+                // Check if we've finished routing this net
+                allRouted = true;
+                for(i = 0; i < gridStruct->currentNodes.size(); i++)
+                {
+                    if(gridStruct->currentNodes[i]->currentCellProp == CELL_NET_SINK_UNCONN)
+                    {
+                        allRouted = false;
+                    }
+                }
+                if(allRouted)
+                {
+                    FinishNet(parsedInputStruct, gridStruct);
+                }
+            }
+            // Anything else is in our way (the edge of the grid included), find a way around it
+            else
+            {
+                if(gridStruct->verbose)
+                {
+                    printf("Uh oh, obstruction...\n");
+                }
+
+                // Start expansion!
+                gridStruct->currentRoutingState = STATE_EXPANSION;
+            }
+
+            break;
+        case STATE_EXPANSION:
+            // Search for a way around what we ran into
+            detour.clear();
+            if(!FindDetour(gridStruct, &detour))
+            {
+                if(gridStruct->verbose)
+                {
+                    printf("No way around the obstruction for net %d\n", gridStruct->currentNet);
+                }
+                FailNet(parsedInputStruct, gridStruct);
+                break;
+            }
+
+            // Route the detour and carry on seeking from the end of it
+            for(i = 0; i < detour.size(); i++)
+            {
+                SetCellNet(gridStruct, detour[i], gridStruct->currentNet);
+                SetCellProp(gridStruct, detour[i], CELL_NET_WIRE_CONN);
+                gridStruct->lastRoute.push_back(detour[i]);
+            }
+            gridStruct->currentTelemetry.walkbackLength += detour.size();
+            SetSeekDirection(gridStruct->lastRoute.back(), gridStruct);
+
+            // We can seek again!
+            gridStruct->currentRoutingState = STATE_SEEK;
+            break;
+        default:
+            break;
+    }
+}
+
+bool FindDetour(gridStruct_t *gridStruct, std::vector<cellStruct_t*> *detour)
+{
+    unsigned int i, dir, bucket, startDistance, distance;
+    unsigned int distanceDelta[DIR_IDX_NUM];
+    posStruct_t endPos;
+    std::vector<unsigned int> cursor;
+    cellStruct_t *startCell, *currentCell, *nextCell, *endCell;
+    cellStruct_t *neighbours[DIR_NUM];
+
+    // Best first search from where we got stuck, always expanding the open cell closest to the next node
+    // Cells are kept in buckets by their Manhattan distance to the node, which only changes by one with each step
+    startCell = gridStruct->lastRoute.back();
+    GetDistanceDelta(gridStruct, startCell, gridStruct->nextNodePointer, distanceDelta);
+    startDistance = distanceDelta[DIR_IDX_EW_X] + distanceDelta[DIR_IDX_NS_Y] + distanceDelta[DIR_IDX_UD_Z];
+    SetCellLabel(gridStruct, startCell, startDistance);
+    startCell->prevDir = DIR_NUM;
+    gridStruct->expansionList.resize(startDistance + 1);
+    gridStruct->expansionList[startDistance].push_back(startCell);
+    cursor.assign(startDistance + 1, 0);
+    bucket = startDistance;
+    endCell = NULL;
+
+    while(endCell == NULL)
+    {
+        // Move on to the closest bucket that still has cells to expand, if there are none we're boxed in
+        while(bucket < gridStruct->expansionList.size() && cursor[bucket] == gridStruct->expansionList[bucket].size())
+        {
+            bucket++;
+        }
+        if(bucket >= gridStruct->expansionList.size())
+        {
+            break;
+        }
+        currentCell = gridStruct->expansionList[bucket][cursor[bucket]++];
+        GetNeighbours(gridStruct, currentCell, neighbours);
+
+        // For each cardinal direction
+        for(dir = DIR_NORTH; dir < DIR_NUM; dir++)
+        {
+            nextCell = neighbours[dir];
+
+            // Make sure we have a cell to look at
+            if(nextCell == NULL)
+            {
+                continue;
+            }
+            // Right next to the node, seeking takes it from here
+            else if(nextCell == gridStruct->nextNodePointer)
+            {
+                endCell = currentCell;
+                break;
+            }
+            // Check if the cell is routeable and we haven't been there yet
+            else if(nextCell->currentCellProp == CELL_EMPTY && GetCellLabel(gridStruct, nextCell) == -1 && !IsReservedCell(gridStruct, nextCell))
+            {
+                GetDistanceDelta(gridStruct, nextCell, gridStruct->nextNodePointer, distanceDelta);
+                distance = distanceDelta[DIR_IDX_EW_X] + distanceDelta[DIR_IDX_NS_Y] + distanceDelta[DIR_IDX_UD_Z];
+                SetCellLabel(gridStruct, nextCell, distance);
+                nextCell->prevDir = GetOppositeDirection(dir);
+                gridStruct->currentTelemetry.cellsExpanded++;
+                if(gridStruct->expansionList.size() <= distance)
+                {
+                    gridStruct->expansionList.resize(distance + 1);
+                    cursor.resize(distance + 1, 0);
+                }
+                gridStruct->expansionList[distance].push_back(nextCell);
+                bucket = std::min(bucket, distance);
+                // Closer than where we got stuck, we've made it around
+                if(distance < startDistance)
+                {
+                    endCell = nextCell;
+                    break;
+                }
+            }
+        }
+    }
+
+    // Keep track of how far the search spread
+    gridStruct->currentTelemetry.expansionLayers++;
+    for(i = 0; i < gridStruct->expansionList.size(); i++)
+    {
+        if(gridStruct->expansionList[i].size() > gridStruct->currentTelemetry.frontierPeak)
+        {
+            gridStruct->currentTelemetry.frontierPeak = gridStruct->expansionList[i].size();
+        }
+    }
+
+    // Follow the cells back to where we got stuck, the detour is every cell after it
+    if(endCell != NULL)
+    {
+        for(currentCell = endCell; currentCell != startCell; currentCell = GetNeighbour(gridStruct, currentCell, currentCell->prevDir))
+        {
+            detour->push_back(currentCell);
+        }
+        std::reverse(detour->begin(), detour->end());
+        if(gridStruct->verbose)
+        {
+            GetCellPos(gridStruct, endCell, &endPos);
+            printf("Found a detour of %d cell(s) to (%d, %d, %d)\n", (int)detour->size(), endPos.posX, endPos.posY, endPos.posZ);
+        }
+    }
+
+    // Clean up after ourselves
+    ResetCellExpansion(gridStruct);
+    gridStruct->expansionList.clear();
+
+    return endCell != NULL;
+}
+
+void SetSeekDirection(cellStruct_t *cell, gridStruct_t *gridStruct)
+{
+    unsigned int distanceDelta[DIR_IDX_NUM];
+    posStruct_t pos, nextPos;
+
+    // Determine the direction of the next node and take note of how long each direction is
+    GetDirection(cell, gridStruct->nextNodePointer, gridStruct);
+    GetDistanceDelta(gridStruct, cell, gridStruct->nextNodePointer, distanceDelta);
+
+    if(gridStruct->verbose)
+    {
+        GetCellPos(gridStruct, cell, &pos);
+        GetCellPos(gridStruct, gridStruct->nextNodePointer, &nextPos);
+        printf("Deltas between (%d, %d, %d) and (%d, %d, %d) is (%d, %d, %d)\n",
+            pos.posX,
+            pos.posY,
+            pos.posZ,
+            nextPos.posX,
+            nextPos.posY,
+            nextPos.posZ,
+            distanceDelta[DIR_IDX_EW_X], distanceDelta[DIR_IDX_NS_Y], distanceDelta[DIR_IDX_UD_Z]);
+    }
+
+    // Head into the longest direction (only change layers once we're lined up)
+    if(distanceDelta[DIR_IDX_EW_X] == 0 && distanceDelta[DIR_IDX_NS_Y] == 0)
+    {
+        gridStruct->directionIndex = DIR_IDX_UD_Z;
+    }
+    else if(distanceDelta[DIR_IDX_EW_X] > distanceDelta[DIR_IDX_NS_Y])
+    {
+        gridStruct->directionIndex = DIR_IDX_EW_X;
+    }
+    else
+    {
+        gridStruct->directionIndex = DIR_IDX_NS_Y;
+    }
+}
+
+void GetDirection(cellStruct_t *cell0, cellStruct_t *cell1, gridStruct_t *gridStruct)
+{
+    posStruct_t pos0, pos1;
+
+    GetCellPos(gridStruct, cell0, &pos0);
+    GetCellPos(gridStruct, cell1, &pos1);
+
+    // Find up/down
+    if(pos0.posY < pos1.posY)
+    {
+        gridStruct->nextNodeDir[DIR_IDX_NS_Y] = DIR_SOUTH;
+    }
+    else
+    {
+        gridStruct->nextNodeDir[DIR_IDX_NS_Y] = DIR_NORTH;
+    }
+    // Find left/right
+    if(pos0.posX < pos1.posX)
+    {
+        gridStruct->nextNodeDir[DIR_IDX_EW_X] = DIR_EAST;
+    }
+    else
+    {
+        gridStruct->nextNodeDir[DIR_IDX_EW_X] = DIR_WEST;
+    }
+    // Find the layer above/below
+    if(pos0.posZ < pos1.posZ)
+    {
+        gridStruct->nextNodeDir[DIR_IDX_UD_Z] = DIR_UP;
+    }
+    else
+    {
+        gridStruct->nextNodeDir[DIR_IDX_UD_Z] = DIR_DOWN;
+    }
+}
+
+void GetDistanceDelta(gridStruct_t *gridStruct, cellStruct_t *cell0, cellStruct_t *cell1, unsigned int * distanceDelta)
+{
+    posStruct_t pos0, pos1;
+
+    GetCellPos(gridStruct, cell0, &pos0);
+    GetCellPos(gridStruct, cell1, &pos1);
+    distanceDelta[DIR_IDX_EW_X] = abs((int)pos0.posX - (int)(pos1.posX));
+    distanceDelta[DIR_IDX_NS_Y] = abs((int)pos0.posY - (int)(pos1.posY));
+    distanceDelta[DIR_IDX_UD_Z] = abs((int)pos0.posZ - (int)(pos1.posZ));
+}
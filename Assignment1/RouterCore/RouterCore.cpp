@@ -0,0 +1,4174 @@
+#define _CRT_SECURE_NO_WARNINGS //  Disable unsafe warnings, to enable use of sprintf within VS2017
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#ifndef WIN32
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "graphics.h"
+#include "RouterCore.h"
+
+parsedInputStruct_t *input = new parsedInputStruct_t();
+gridStruct_t *grid = new gridStruct_t();
+
+// Globals used to center grid in window
+// TODO: find a better way to do this
+int cellSizeX, cellSizeY, gridMarginX, gridMarginY;
+// The routing layer currently shown on screen
+unsigned int displayLayer = 0;
+
+// Routing in the background, only the routing thread touches the grid while it runs
+std::thread routingThread;
+std::atomic<bool> routingDone(false);                   ///< Set by the routing thread once it stops stepping
+std::atomic<bool> routingCancelled(false);              ///< Set by the window to stop the routing thread after its current step
+std::mutex snapshotMutex;                               ///< Guards latestSnapshot
+std::shared_ptr<const gridSnapshot_t> latestSnapshot;   ///< The last snapshot published by the routing thread
+std::shared_ptr<const gridSnapshot_t> drawnSnapshot;    ///< The snapshot on screen while the routing thread runs
+std::vector<posStruct_t> pendingChangedCells;           ///< The cells changed in the snapshots published since the window last took one, guarded by snapshotMutex
+bool pendingAllCellsChanged = false;                    ///< Whether the whole grid may have changed in those snapshots, guarded by snapshotMutex
+
+// What's on screen, so only the cells that changed since the last frame get redrawn
+std::vector<posStruct_t> screenChangedCells;            ///< The cells changed since they were last drawn, repeats included
+bool screenAllCellsChanged = true;                      ///< Whether the whole grid needs drawing again
+unsigned int screenLayer = 0;                           ///< The layer on screen when it was last drawn
+bool drawCellText = true;                               ///< Whether cells are big enough on screen for their labels and numbers
+bool drawCellOutlines = true;                           ///< Whether cells are big enough on screen for the outlines of empty cells
+
+color_types netColors[MAX_NET_COLORS] =
+{
+    RED, ORANGE, YELLOW, GREEN, DARKGREEN, BLUE, CYAN, MAGENTA
+};
+
+// The RGB values of every color_types entry, the same as easygl draws them on Win32
+unsigned char imageColors[NUM_COLOR][3] =
+{
+    {255, 255, 255}, {0, 0, 0}, {128, 128, 128}, {192, 192, 192}, {0, 0, 255}, {0, 255, 0},
+    {255, 255, 0}, {0, 255, 255}, {255, 0, 0}, {0, 128, 0}, {255, 0, 255}, {255, 128, 0}
+};
+
+int RouterMain(int argc, char **argv, const routerEngine_t *defaultEngine)
+{
+    int i, layers, threads;
+    unsigned int domainsX, domainsY;
+    bool batch;
+    std::vector<std::string> inputArguments;
+    std::vector<std::string> inputFilenames;
+    char *binaryFilename;
+    char *deltaFilename;
+    const char * filename;
+    //const char * filename = "..\\benchmarks\\kuma.infile";
+
+    // Check for optional flags after the filename
+    grid->engine = defaultEngine;
+    layers = 0;
+    threads = 0;
+    grid->imageCellPixels = IMAGE_CELL_PIXELS;
+    batch = false;
+    binaryFilename = NULL;
+    deltaFilename = NULL;
+    domainsX = 1;
+    domainsY = 1;
+    grid->seed = unsigned(std::time(0));
+    for(i = 1; i < argc; i++)
+    {
+        // Input files, directories of them and lists of them
+        if(argv[i][0] != '-')
+        {
+            inputArguments.push_back(argv[i]);
+            continue;
+        }
+        // Route every input on this many threads (all of the cores by default) and print a table of the results
+        if(strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+        {
+            threads = atoi(argv[++i]);
+            batch = true;
+        }
+        // Echo the input file's contents while parsing, and print every routing step
+        if(strcmp(argv[i], "-v") == 0)
+        {
+            grid->verbose = true;
+        }
+        // Route the whole grid without opening a window
+        if(strcmp(argv[i], "-n") == 0)
+        {
+            batch = true;
+        }
+        // Convert the input file to a binary grid instead of routing it
+        if(strcmp(argv[i], "-b") == 0 && i + 1 < argc)
+        {
+            binaryFilename = argv[++i];
+        }
+        // Save the routed grid as a binary grid once routing finishes (appended to every input's name in a batch)
+        if(strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+        {
+            grid->outputFilename = argv[++i];
+        }
+        // Apply an ECO delta to the input's saved routing and only route what it changed
+        if(strcmp(argv[i], "-e") == 0 && i + 1 < argc)
+        {
+            deltaFilename = argv[++i];
+        }
+        // Write an image of the grid (as PNG, PPM or PostScript) once routing finishes (appended to every input's name in a batch)
+        if(strcmp(argv[i], "-i") == 0 && i + 1 < argc)
+        {
+            grid->imageFilename = argv[++i];
+        }
+        // Override the width and height of a cell in the image, in pixels
+        if(strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+        {
+            grid->imageCellPixels = atoi(argv[++i]);
+        }
+        // Record per net telemetry and write it out (as JSON or CSV) once routing finishes (appended to every input's name in a batch)
+        if(strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+        {
+            grid->telemetryFilename = argv[++i];
+        }
+        // Override the number of routing layers
+        if(strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+        {
+            layers = atoi(argv[++i]);
+        }
+        // Weighted routing with a bucket queue
+        if(strcmp(argv[i], "-w") == 0)
+        {
+            grid->weighted = true;
+        }
+        // Route with another engine (lee, probe, race to probe every net first and fall back to Lee Moore, or channel for grids made of rows of cells)
+        if(strcmp(argv[i], "-a") == 0 && i + 1 < argc)
+        {
+            grid->engine = FindEngine(argv[++i]);
+            if(grid->engine == NULL)
+            {
+                printf("ERROR, unknown engine %s!\n", argv[i]);
+                return -1;
+            }
+        }
+        // Replay cached routes on retries
+        if(strcmp(argv[i], "-c") == 0)
+        {
+            grid->useRouteCache = true;
+        }
+        // Rip up blocking nets instead of restarting
+        if(strcmp(argv[i], "-r") == 0)
+        {
+            grid->ripUp = true;
+        }
+        // Store the grid in tiles instead of columns
+        if(strcmp(argv[i], "-t") == 0)
+        {
+            grid->tiledLayout = true;
+        }
+        // Stop retrying after this many seconds and settle for the best grid so far
+        if(strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+        {
+            grid->timeBudget = atof(argv[++i]);
+        }
+        // Give up on a net once its expansions have labelled this many cells
+        if(strcmp(argv[i], "-x") == 0 && i + 1 < argc)
+        {
+            grid->expansionCap = strtoull(argv[++i], NULL, 10);
+        }
+        // Keep the cells in this file instead of memory, only a working set of tiles stays resident (appended to every input's name in a batch)
+        if(strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+        {
+            grid->gridFilename = argv[++i];
+        }
+        // Override the number of tiles of the grid file kept resident between nets
+        if(strcmp(argv[i], "-k") == 0 && i + 1 < argc)
+        {
+            grid->residentTiles = atoi(argv[++i]);
+        }
+        // Seed the net order shuffling with this instead of the time, to repeat a run
+        if(strcmp(argv[i], "-g") == 0 && i + 1 < argc)
+        {
+            grid->seed = strtoul(argv[++i], NULL, 10);
+        }
+        // Split the grid into columns x rows domains (or N x N), each routed by its own worker process, before routing the nets left over on the whole grid
+        if(strcmp(argv[i], "-u") == 0 && i + 1 < argc)
+        {
+            if(sscanf(argv[++i], "%ux%u", &domainsX, &domainsY) == 1)
+            {
+                domainsY = domainsX;
+            }
+        }
+        // Reserve an escape cell next to every pin for its net, and route the nets with a walled in pin last
+        if(strcmp(argv[i], "-f") == 0)
+        {
+            grid->reservePinAccess = true;
+        }
+        // Order the nets on every retry by how they failed before (shuffle, recent or frequent)
+        if(strcmp(argv[i], "-q") == 0 && i + 1 < argc)
+        {
+            if(!ParseRetryPolicy(argv[++i], &grid->retryPolicy))
+            {
+                printf("ERROR, unknown retry policy %s!\n", argv[i]);
+                return -1;
+            }
+        }
+    }
+
+    // Seed the net order shuffling once per run
+    grid->rng.seed(grid->seed);
+
+    // Directories, lists and more than one input are routed as a batch
+    for(i = 0; i < (int)inputArguments.size(); i++)
+    {
+        if(!ListInputFiles(inputArguments[i].c_str(), &inputFilenames))
+        {
+            return -1;
+        }
+    }
+    if(inputFilenames.empty())
+    {
+        printf("ERROR, no input files given!\n");
+        return -1;
+    }
+    if(inputFilenames.size() > 1 || inputArguments.size() > 1 || inputFilenames[0] != inputArguments[0] || threads > 0)
+    {
+        if(binaryFilename != NULL || deltaFilename != NULL || domainsX * domainsY > 1)
+        {
+            printf("ERROR, -b, -e and -u only work on a single input file!\n");
+            return -1;
+        }
+        return RouteBatch(&inputFilenames, grid, layers, threads) ? 0 : 1;
+    }
+    filename = inputFilenames[0].c_str();
+
+    // Parse input file (binary grids are loaded straight from their mapping)
+    if(IsBinaryGridFile(filename) ? !LoadBinaryGrid(filename, input, grid) : !ParseInputFile(filename, input, grid->verbose))
+    {
+        return -1;
+    }
+    if(layers > 0)
+    {
+        input->gridSizeZ = layers;
+    }
+    // Apply the ECO delta, ripping up the saved routes it runs into
+    if(deltaFilename != NULL && !ApplyRoutingDelta(deltaFilename, input, grid))
+    {
+        return -1;
+    }
+    // Convert the input and stop there
+    if(binaryFilename != NULL)
+    {
+        return SaveBinaryGrid(binaryFilename, input, NULL) ? 0 : -1;
+    }
+    // Route what the domains can on their own, their routing is picked up like a binary grid's
+    if(domainsX * domainsY > 1 && !RouteDomains(input, grid, domainsX, domainsY))
+    {
+        return -1;
+    }
+    // Initialize the router
+    if(!RouterInit(input, grid))
+    {
+        return -1;
+    }
+    // Pick up from the binary grid's routing, if it has one
+    RestoreSavedRouting(input, grid);
+
+    // Route straight through with the same engine the window steps through
+    if(batch)
+    {
+        RouterRun(input, grid, STEP_COMPLETE);
+        return (grid->currentRoutingState == STATE_ROUTE_SUCCESS) ? 0 : 1;
+    }
+
+    // Scale cells and padding to current grid
+    cellSizeX = 1280 / (input->gridSizeX + 4);
+    cellSizeY = cellSizeX;
+    gridMarginX = cellSizeX * 2;
+    gridMarginY = gridMarginX;
+
+    /* initialize display with BLACK background */
+    init_graphics("Router", BACKGROUND_COLOR);
+
+    /* still picture drawing allows user to zoom, etc. */
+    // Set-up coordinates from (xl,ytop) = (0,0) to 
+    // (xr,ybot) = (1000,1000)
+    // init_graphics scaled the window based on a factor of the current resolution
+    // TODO: make it dynamic
+    init_world(0., 0., 1280., 864.);
+
+    // Keep track of the cells that change from here on, the window redraws just those
+    grid->trackChangedCells = true;
+
+    // Draw screen a first time
+    DrawScreen();
+
+    update_message("Setup complete, ready to start route!");
+
+    // Enable key presses
+    set_keypress_input(true);
+
+    // Start main event loop
+    event_loop(ActOnButtonPress, ActOnMouseMove, ActOnKeyPress, DrawScreen);
+
+    // Don't leave the routing thread running on its own
+    StopRoutingThread();
+
+    close_graphics();
+    printf("Graphics closed down.\n");
+
+    return (0);
+}
+
+const routerEngine_t* FindEngine(const char *key)
+{
+    unsigned int i;
+    const routerEngine_t *engines[] = {&leeMooreEngine, &lineProbeEngine, &raceEngine, &channelEngine};
+
+    for(i = 0; i < sizeof(engines) / sizeof(engines[0]); i++)
+    {
+        if(strcmp(engines[i]->key, key) == 0)
+        {
+            return engines[i];
+        }
+    }
+
+    return NULL;
+}
+
+cellStruct_t* GetCell(gridStruct_t *gridStruct, unsigned int x, unsigned int y, unsigned int z)
+{
+    // Tiles are stored row by row, one layer after the other, and each tile keeps its cells row by row
+    if(gridStruct->tiledLayout)
+    {
+        // Grid files hold the same tiles, one after the other in the mapping
+        if(gridStruct->gridFile.data != NULL)
+        {
+            return GetTileCells(&gridStruct->gridFile, PLANE_CELLS, ((size_t)z * gridStruct->gridTilesY + y / GRID_TILE_SIZE) * gridStruct->gridTilesX + x / GRID_TILE_SIZE) +
+                (y % GRID_TILE_SIZE) * GRID_TILE_SIZE + x % GRID_TILE_SIZE;
+        }
+        return &gridStruct->cells[((size_t)(z * gridStruct->gridTilesY + y / GRID_TILE_SIZE) * gridStruct->gridTilesX + x / GRID_TILE_SIZE) * gridStruct->cellBlockSize +
+                                  (y % GRID_TILE_SIZE) * GRID_TILE_SIZE + x % GRID_TILE_SIZE];
+    }
+    // Layers are stored one after the other, each as gridSizeX columns
+    return &gridStruct->cells[((size_t)z * gridStruct->gridSizeX + x) * gridStruct->cellBlockSize + y];
+}
+
+size_t GetCellIndex(gridStruct_t *gridStruct, cellStruct_t *cell)
+{
+    size_t offset;
+
+    // The grid file pads its tiles out to whole pages, so a cell's index is its tile's first index plus its place in the tile
+    if(gridStruct->gridFile.data != NULL)
+    {
+        offset = (size_t)((char *)cell - gridStruct->gridFile.data);
+        return offset / gridStruct->gridFile.tileStride * gridStruct->cellBlockSize + offset % gridStruct->gridFile.tileStride / sizeof(cellStruct_t);
+    }
+    return (size_t)(cell - gridStruct->cells.data());
+}
+
+void GetCellPos(gridStruct_t *gridStruct, cellStruct_t *cell, posStruct_t *pos)
+{
+    size_t index, block, place;
+
+    // Undo GetCell, the block is the column (or tile) the cell is in and the place is where it is in the block
+    index = GetCellIndex(gridStruct, cell);
+    block = index / gridStruct->cellBlockSize;
+    place = index % gridStruct->cellBlockSize;
+    if(gridStruct->tiledLayout)
+    {
+        pos->posX = (unsigned int)(block % gridStruct->gridTilesX * GRID_TILE_SIZE + place % GRID_TILE_SIZE);
+        pos->posY = (unsigned int)(block / gridStruct->gridTilesX % gridStruct->gridTilesY * GRID_TILE_SIZE + place / GRID_TILE_SIZE);
+        pos->posZ = (unsigned int)(block / gridStruct->gridTilesX / gridStruct->gridTilesY);
+    }
+    else
+    {
+        pos->posX = (unsigned int)(block % gridStruct->gridSizeX);
+        pos->posY = (unsigned int)place;
+        pos->posZ = (unsigned int)(block / gridStruct->gridSizeX);
+    }
+}
+
+cellStruct_t* GetNeighbour(gridStruct_t *gridStruct, cellStruct_t *cell, unsigned int dir)
+{
+    posStruct_t pos;
+    size_t index, layerSize;
+
+    //1. Columns are stored one after the other, so only the coordinate the direction moves along needs working out
+    if(!gridStruct->tiledLayout)
+    {
+        index = GetCellIndex(gridStruct, cell);
+        layerSize = (size_t)gridStruct->gridSizeX * gridStruct->gridSizeY;
+        switch(dir)
+        {
+            case DIR_NORTH:
+                return (index % gridStruct->gridSizeY != 0) ? cell - 1 : NULL;
+            case DIR_EAST:
+                return (index / gridStruct->gridSizeY % gridStruct->gridSizeX != gridStruct->gridSizeX - 1) ? cell + gridStruct->gridSizeY : NULL;
+            case DIR_SOUTH:
+                return (index % gridStruct->gridSizeY != gridStruct->gridSizeY - 1) ? cell + 1 : NULL;
+            case DIR_WEST:
+                return (index / gridStruct->gridSizeY % gridStruct->gridSizeX != 0) ? cell - gridStruct->gridSizeY : NULL;
+            case DIR_UP:
+                return (index / layerSize != gridStruct->gridSizeZ - 1) ? cell + layerSize : NULL;
+            case DIR_DOWN:
+                return (index >= layerSize) ? cell - layerSize : NULL;
+            default:
+                return NULL;
+        }
+    }
+
+    //2. Tiles break that up, look up just the one neighbour
+    GetCellPos(gridStruct, cell, &pos);
+    switch(dir)
+    {
+        case DIR_NORTH:
+            return (pos.posY != 0) ? GetCell(gridStruct, pos.posX, pos.posY - 1, pos.posZ) : NULL;
+        case DIR_EAST:
+            return (pos.posX != gridStruct->gridSizeX - 1) ? GetCell(gridStruct, pos.posX + 1, pos.posY, pos.posZ) : NULL;
+        case DIR_SOUTH:
+            return (pos.posY != gridStruct->gridSizeY - 1) ? GetCell(gridStruct, pos.posX, pos.posY + 1, pos.posZ) : NULL;
+        case DIR_WEST:
+            return (pos.posX != 0) ? GetCell(gridStruct, pos.posX - 1, pos.posY, pos.posZ) : NULL;
+        case DIR_UP:
+            return (pos.posZ != gridStruct->gridSizeZ - 1) ? GetCell(gridStruct, pos.posX, pos.posY, pos.posZ + 1) : NULL;
+        case DIR_DOWN:
+            return (pos.posZ != 0) ? GetCell(gridStruct, pos.posX, pos.posY, pos.posZ - 1) : NULL;
+        default:
+            return NULL;
+    }
+}
+
+void GetNeighbours(gridStruct_t *gridStruct, cellStruct_t *cell, cellStruct_t **neighbours)
+{
+    posStruct_t pos;
+    size_t layerSize;
+
+    //1. Cells on the grid's edges have no neighbours past them (NULL, indexed by cardinalDir_e)
+    GetCellPos(gridStruct, cell, &pos);
+    neighbours[DIR_NORTH] = NULL;
+    neighbours[DIR_EAST] = NULL;
+    neighbours[DIR_SOUTH] = NULL;
+    neighbours[DIR_WEST] = NULL;
+    neighbours[DIR_UP] = NULL;
+    neighbours[DIR_DOWN] = NULL;
+
+    //2. Columns are stored one after the other, so the neighbours are a fixed distance away
+    if(!gridStruct->tiledLayout)
+    {
+        layerSize = (size_t)gridStruct->gridSizeX * gridStruct->gridSizeY;
+        if(pos.posY != 0)
+        {
+            neighbours[DIR_NORTH] = cell - 1;
+        }
+        if(pos.posX != gridStruct->gridSizeX - 1)
+        {
+            neighbours[DIR_EAST] = cell + gridStruct->gridSizeY;
+        }
+        if(pos.posY != gridStruct->gridSizeY - 1)
+        {
+            neighbours[DIR_SOUTH] = cell + 1;
+        }
+        if(pos.posX != 0)
+        {
+            neighbours[DIR_WEST] = cell - gridStruct->gridSizeY;
+        }
+        if(pos.posZ != gridStruct->gridSizeZ - 1)
+        {
+            neighbours[DIR_UP] = cell + layerSize;
+        }
+        if(pos.posZ != 0)
+        {
+            neighbours[DIR_DOWN] = cell - layerSize;
+        }
+        return;
+    }
+
+    //3. Tiles (and the grid file's padding between them) break that up, look them up instead
+    if(pos.posY != 0)
+    {
+        neighbours[DIR_NORTH] = GetCell(gridStruct, pos.posX, pos.posY - 1, pos.posZ);
+    }
+    if(pos.posX != gridStruct->gridSizeX - 1)
+    {
+        neighbours[DIR_EAST] = GetCell(gridStruct, pos.posX + 1, pos.posY, pos.posZ);
+    }
+    if(pos.posY != gridStruct->gridSizeY - 1)
+    {
+        neighbours[DIR_SOUTH] = GetCell(gridStruct, pos.posX, pos.posY + 1, pos.posZ);
+    }
+    if(pos.posX != 0)
+    {
+        neighbours[DIR_WEST] = GetCell(gridStruct, pos.posX - 1, pos.posY, pos.posZ);
+    }
+    if(pos.posZ != gridStruct->gridSizeZ - 1)
+    {
+        neighbours[DIR_UP] = GetCell(gridStruct, pos.posX, pos.posY, pos.posZ + 1);
+    }
+    if(pos.posZ != 0)
+    {
+        neighbours[DIR_DOWN] = GetCell(gridStruct, pos.posX, pos.posY, pos.posZ - 1);
+    }
+}
+
+int GetCellNet(cellStruct_t *cell)
+{
+    // -1 if no net has been routed through the cell
+    return (int)cell->net - 1;
+}
+
+void SetCellNet(gridStruct_t *gridStruct, cellStruct_t *cell, int net)
+{
+    cell->net = (net < 0) ? CELL_NO_NET : (unsigned int)(net + 1);
+    MarkCellChanged(gridStruct, cell);
+}
+
+void SetCellProp(gridStruct_t *gridStruct, cellStruct_t *cell, cellProp_e prop)
+{
+    cell->currentCellProp = prop;
+    MarkCellChanged(gridStruct, cell);
+}
+
+void MarkCellChanged(gridStruct_t *gridStruct, cellStruct_t *cell)
+{
+    posStruct_t pos;
+
+    // Only the window's grid keeps track, and once everything may have changed there's no point
+    if(!gridStruct->trackChangedCells || gridStruct->allCellsChanged)
+    {
+        return;
+    }
+    // Redrawing more cells than the grid has is no cheaper than redrawing the grid
+    if(gridStruct->changedCells.size() >= (size_t)gridStruct->gridSizeX * gridStruct->gridSizeY * gridStruct->gridSizeZ)
+    {
+        gridStruct->changedCells.clear();
+        gridStruct->allCellsChanged = true;
+        return;
+    }
+    GetCellPos(gridStruct, cell, &pos);
+    gridStruct->changedCells.push_back(pos);
+}
+
+int* FindCellLabel(gridStruct_t *gridStruct, cellStruct_t *cell)
+{
+    size_t index;
+
+    // The grid file's label plane has the same tiles as its cells
+    index = GetCellIndex(gridStruct, cell);
+    if(gridStruct->gridFile.data != NULL)
+    {
+        return (int *)GetTileCells(&gridStruct->gridFile, PLANE_LABELS, index / gridStruct->cellBlockSize) + index % gridStruct->cellBlockSize;
+    }
+    return &gridStruct->cellLabels[index];
+}
+
+int GetCellLabel(gridStruct_t *gridStruct, cellStruct_t *cell)
+{
+    return *FindCellLabel(gridStruct, cell);
+}
+
+void SetCellLabel(gridStruct_t *gridStruct, cellStruct_t *cell, int label)
+{
+    *FindCellLabel(gridStruct, cell) = label;
+    MarkCellChanged(gridStruct, cell);
+}
+
+void ResetCellLabels(gridStruct_t *gridStruct)
+{
+    size_t i;
+    int *labels;
+
+    // Every number on screen goes
+    gridStruct->allCellsChanged = true;
+
+    // Sweeping the grid file's label plane mustn't leave all of it resident either
+    if(gridStruct->gridFile.data != NULL)
+    {
+        for(i = 0; i < gridStruct->gridFile.numTiles; i++)
+        {
+            labels = (int *)GetTileCells(&gridStruct->gridFile, PLANE_LABELS, i);
+            std::fill(labels, labels + gridStruct->cellBlockSize, -1);
+            if(!gridStruct->gridFile.inWorkingSet[i])
+            {
+                DiscardTile(&gridStruct->gridFile, PLANE_LABELS, i);
+            }
+        }
+        return;
+    }
+    gridStruct->cellLabels.assign(gridStruct->cells.size(), -1);
+}
+
+bool MapFile(const char *filename, mappedFile_t *mappedFile)
+{
+    mappedFile->data = NULL;
+    mappedFile->size = 0;
+#ifdef WIN32
+    LARGE_INTEGER fileSize;
+
+    mappedFile->mapHandle = NULL;
+    mappedFile->fileHandle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(mappedFile->fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    if(!GetFileSizeEx(mappedFile->fileHandle, &fileSize))
+    {
+        UnmapFile(mappedFile);
+        return false;
+    }
+    mappedFile->size = (size_t)fileSize.QuadPart;
+    // Empty files can't be mapped, there's nothing to read anyway
+    if(mappedFile->size == 0)
+    {
+        return true;
+    }
+    mappedFile->mapHandle = CreateFileMappingA(mappedFile->fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if(mappedFile->mapHandle == NULL)
+    {
+        UnmapFile(mappedFile);
+        return false;
+    }
+    mappedFile->data = (const char *)MapViewOfFile(mappedFile->mapHandle, FILE_MAP_READ, 0, 0, 0);
+#else
+    struct stat fileStat;
+    void *data;
+
+    mappedFile->fileDescriptor = open(filename, O_RDONLY);
+    if(mappedFile->fileDescriptor < 0)
+    {
+        return false;
+    }
+    if(fstat(mappedFile->fileDescriptor, &fileStat) != 0)
+    {
+        UnmapFile(mappedFile);
+        return false;
+    }
+    mappedFile->size = (size_t)fileStat.st_size;
+    // Empty files can't be mapped, there's nothing to read anyway
+    if(mappedFile->size == 0)
+    {
+        return true;
+    }
+    data = mmap(NULL, mappedFile->size, PROT_READ, MAP_PRIVATE, mappedFile->fileDescriptor, 0);
+    if(data != MAP_FAILED)
+    {
+        mappedFile->data = (const char *)data;
+        // We only ever walk the file front to back
+        madvise(data, mappedFile->size, MADV_SEQUENTIAL);
+    }
+#endif
+    if(mappedFile->data == NULL)
+    {
+        UnmapFile(mappedFile);
+        return false;
+    }
+    return true;
+}
+
+void UnmapFile(mappedFile_t *mappedFile)
+{
+#ifdef WIN32
+    if(mappedFile->data != NULL)
+    {
+        UnmapViewOfFile(mappedFile->data);
+    }
+    if(mappedFile->mapHandle != NULL)
+    {
+        CloseHandle(mappedFile->mapHandle);
+    }
+    if(mappedFile->fileHandle != INVALID_HANDLE_VALUE)
+    {
+        CloseHandle(mappedFile->fileHandle);
+    }
+    mappedFile->mapHandle = NULL;
+    mappedFile->fileHandle = INVALID_HANDLE_VALUE;
+#else
+    if(mappedFile->data != NULL)
+    {
+        munmap((void *)mappedFile->data, mappedFile->size);
+    }
+    if(mappedFile->fileDescriptor >= 0)
+    {
+        close(mappedFile->fileDescriptor);
+    }
+    mappedFile->fileDescriptor = -1;
+#endif
+    mappedFile->data = NULL;
+    mappedFile->size = 0;
+}
+
+bool MapGridFile(const char *filename, gridFile_t *gridFile, size_t numTiles, size_t tileSize)
+{
+    size_t pageSize;
+#ifdef WIN32
+    SYSTEM_INFO systemInfo;
+
+    GetSystemInfo(&systemInfo);
+    pageSize = systemInfo.dwPageSize;
+#else
+    pageSize = (size_t)sysconf(_SC_PAGESIZE);
+#endif
+
+    //1. Round the tiles up to whole pages so every tile can be dropped from memory on its own
+    gridFile->tileStride = (tileSize + pageSize - 1) / pageSize * pageSize;
+    gridFile->numTiles = numTiles;
+    gridFile->size = gridFile->tileStride * numTiles * PLANE_NUM;
+
+    //2. Create the file at its full size and map all of it, pages are only read in once they're touched
+#ifdef WIN32
+    gridFile->fileHandle = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if(gridFile->fileHandle == INVALID_HANDLE_VALUE)
+    {
+        return false;
+    }
+    gridFile->mapHandle = CreateFileMappingA(gridFile->fileHandle, NULL, PAGE_READWRITE, (DWORD)((unsigned long long)gridFile->size >> 32), (DWORD)(gridFile->size & 0xFFFFFFFF), NULL);
+    if(gridFile->mapHandle == NULL)
+    {
+        CloseHandle(gridFile->fileHandle);
+        return false;
+    }
+    gridFile->data = (char *)MapViewOfFile(gridFile->mapHandle, FILE_MAP_ALL_ACCESS, 0, 0, gridFile->size);
+    if(gridFile->data == NULL)
+    {
+        CloseHandle(gridFile->mapHandle);
+        CloseHandle(gridFile->fileHandle);
+        return false;
+    }
+#else
+    gridFile->fileDescriptor = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(gridFile->fileDescriptor < 0)
+    {
+        return false;
+    }
+    if(ftruncate(gridFile->fileDescriptor, gridFile->size) != 0)
+    {
+        close(gridFile->fileDescriptor);
+        return false;
+    }
+    gridFile->data = (char *)mmap(NULL, gridFile->size, PROT_READ | PROT_WRITE, MAP_SHARED, gridFile->fileDescriptor, 0);
+    if(gridFile->data == MAP_FAILED)
+    {
+        gridFile->data = NULL;
+        close(gridFile->fileDescriptor);
+        return false;
+    }
+#endif
+
+    //3. Nothing's in the working set yet
+    gridFile->lruTiles.clear();
+    gridFile->lruPositions.assign(numTiles, gridFile->lruTiles.end());
+    gridFile->inWorkingSet.assign(numTiles, false);
+    gridFile->tileChanged.assign(numTiles, false);
+    gridFile->changedTiles.clear();
+    gridFile->allChanged = true;
+    return true;
+}
+
+void UnmapGridFile(gridFile_t *gridFile)
+{
+    // The handles are only open while the file is mapped
+    if(gridFile->data == NULL)
+    {
+        return;
+    }
+#ifdef WIN32
+    UnmapViewOfFile(gridFile->data);
+    CloseHandle(gridFile->mapHandle);
+    CloseHandle(gridFile->fileHandle);
+#else
+    munmap(gridFile->data, gridFile->size);
+    close(gridFile->fileDescriptor);
+#endif
+    gridFile->data = NULL;
+    gridFile->size = 0;
+    gridFile->lruTiles.clear();
+    gridFile->lruPositions.clear();
+    gridFile->inWorkingSet.clear();
+    gridFile->tileChanged.clear();
+    gridFile->changedTiles.clear();
+}
+
+cellStruct_t* GetTileCells(gridFile_t *gridFile, gridPlane_e plane, size_t tile)
+{
+    return (cellStruct_t *)(gridFile->data + ((size_t)plane * gridFile->numTiles + tile) * gridFile->tileStride);
+}
+
+void TouchTile(gridFile_t *gridFile, cellStruct_t *cell)
+{
+    size_t tile;
+
+    // Cells only ever point into the grid being routed, the first plane
+    tile = (size_t)((char *)cell - gridFile->data) / gridFile->tileStride;
+    // Routing only changes the tiles it uses, so they're the only ones the best grid needs again
+    if(!gridFile->tileChanged[tile])
+    {
+        gridFile->tileChanged[tile] = true;
+        gridFile->changedTiles.push_back(tile);
+    }
+    if(!gridFile->lruTiles.empty() && gridFile->lruTiles.front() == tile)
+    {
+        return;
+    }
+    // Move the tile to the front of the working set, or add it there
+    if(gridFile->inWorkingSet[tile])
+    {
+        gridFile->lruTiles.splice(gridFile->lruTiles.begin(), gridFile->lruTiles, gridFile->lruPositions[tile]);
+    }
+    else
+    {
+        gridFile->lruTiles.push_front(tile);
+        gridFile->lruPositions[tile] = gridFile->lruTiles.begin();
+        gridFile->inWorkingSet[tile] = true;
+    }
+}
+
+void TrimWorkingSet(gridFile_t *gridFile)
+{
+    // Drop the least recently used tiles until the working set fits, their cells are read back from the file if they're needed again
+    while(gridFile->lruTiles.size() > gridFile->maxResident)
+    {
+        DiscardTile(gridFile, PLANE_CELLS, gridFile->lruTiles.back());
+        DiscardTile(gridFile, PLANE_LABELS, gridFile->lruTiles.back());
+        gridFile->inWorkingSet[gridFile->lruTiles.back()] = false;
+        gridFile->lruTiles.pop_back();
+    }
+}
+
+void DiscardTile(gridFile_t *gridFile, gridPlane_e plane, size_t tile)
+{
+    // The mapping is shared with the file, so dropping the pages keeps whatever was written to them
+#ifdef WIN32
+    // Unlocking pages that aren't locked takes them out of the working set
+    VirtualUnlock(GetTileCells(gridFile, plane, tile), gridFile->tileStride);
+#else
+    madvise(GetTileCells(gridFile, plane, tile), gridFile->tileStride, MADV_DONTNEED);
+#endif
+}
+
+void CopyGridPlane(gridFile_t *gridFile, gridPlane_e fromPlane, gridPlane_e toPlane)
+{
+    size_t i;
+
+    // Copy tile by tile and drop every tile once it's copied, unless it's one of the working set's tiles of the grid being routed
+    for(i = 0; i < gridFile->numTiles; i++)
+    {
+        memcpy(GetTileCells(gridFile, toPlane, i), GetTileCells(gridFile, fromPlane, i), gridFile->tileStride);
+        if(fromPlane != PLANE_CELLS || !gridFile->inWorkingSet[i])
+        {
+            DiscardTile(gridFile, fromPlane, i);
+        }
+        if(toPlane != PLANE_CELLS || !gridFile->inWorkingSet[i])
+        {
+            DiscardTile(gridFile, toPlane, i);
+        }
+    }
+    if(toPlane == PLANE_CELLS)
+    {
+        gridFile->allChanged = true;
+    }
+}
+
+size_t GetNumCellBlocks(gridStruct_t *gridStruct)
+{
+    // Blocks are the grid file's tiles, or the columns (or tiles) the cells are stored in
+    if(gridStruct->gridFile.data != NULL)
+    {
+        return gridStruct->gridFile.numTiles;
+    }
+    return gridStruct->cells.size() / gridStruct->cellBlockSize;
+}
+
+cellStruct_t* GetCellBlock(gridStruct_t *gridStruct, size_t block, size_t *blockSize)
+{
+    if(gridStruct->gridFile.data != NULL)
+    {
+        // Sweeps can change any tile
+        gridStruct->gridFile.allChanged = true;
+        *blockSize = GRID_TILE_SIZE * GRID_TILE_SIZE;
+        return GetTileCells(&gridStruct->gridFile, PLANE_CELLS, block);
+    }
+    *blockSize = gridStruct->cellBlockSize;
+    return &gridStruct->cells[block * gridStruct->cellBlockSize];
+}
+
+void ReleaseCellBlock(gridStruct_t *gridStruct, size_t block)
+{
+    // Sweeping the whole grid file mustn't leave all of it resident
+    if(gridStruct->gridFile.data != NULL && !gridStruct->gridFile.inWorkingSet[block])
+    {
+        DiscardTile(&gridStruct->gridFile, PLANE_CELLS, block);
+    }
+}
+
+void SaveBestGrid(gridStruct_t *gridStruct)
+{
+    size_t i, tile;
+    gridFile_t *gridFile;
+
+    // The grid file only copies the tiles used since the last save, unless the whole grid has changed since
+    gridFile = &gridStruct->gridFile;
+    if(gridFile->data != NULL)
+    {
+        if(gridFile->allChanged)
+        {
+            CopyGridPlane(gridFile, PLANE_CELLS, PLANE_BEST);
+        }
+        else
+        {
+            for(i = 0; i < gridFile->changedTiles.size(); i++)
+            {
+                tile = gridFile->changedTiles[i];
+                memcpy(GetTileCells(gridFile, PLANE_BEST, tile), GetTileCells(gridFile, PLANE_CELLS, tile), gridFile->tileStride);
+                DiscardTile(gridFile, PLANE_BEST, tile);
+            }
+        }
+        for(i = 0; i < gridFile->changedTiles.size(); i++)
+        {
+            gridFile->tileChanged[gridFile->changedTiles[i]] = false;
+        }
+        gridFile->changedTiles.clear();
+        gridFile->allChanged = false;
+    }
+    else
+    {
+        gridStruct->bestGrid = gridStruct->cells;
+    }
+}
+
+bool RestoreBestGrid(gridStruct_t *gridStruct)
+{
+    // The grid file's best plane is saved along with the first net that's routed
+    if(gridStruct->gridFile.data != NULL)
+    {
+        if(gridStruct->bestNetsRouted == 0)
+        {
+            return false;
+        }
+        CopyGridPlane(&gridStruct->gridFile, PLANE_BEST, PLANE_CELLS);
+        ResetCellLabels(gridStruct);
+        return true;
+    }
+    if(gridStruct->bestGrid.empty())
+    {
+        return false;
+    }
+    gridStruct->cells = gridStruct->bestGrid;
+    // The best grid's expansions are long gone
+    ResetCellLabels(gridStruct);
+    return true;
+}
+
+bool ReadLineInt(const char **cursor, const char *end, int *value)
+{
+    const char *current = *cursor;
+    bool negative = false;
+    int result = 0;
+
+    // Skip the separators between values, but never past the end of the line
+    while(current < end && (*current == ' ' || *current == '\t' || *current == '\r'))
+    {
+        current++;
+    }
+    if(current < end && *current == '-')
+    {
+        negative = true;
+        current++;
+    }
+    if(current >= end || *current < '0' || *current > '9')
+    {
+        *cursor = current;
+        return false;
+    }
+    while(current < end && *current >= '0' && *current <= '9')
+    {
+        result = result * 10 + (*current - '0');
+        current++;
+    }
+
+    *value = negative ? -result : result;
+    *cursor = current;
+    return true;
+}
+
+void NextLine(const char **cursor, const char *end)
+{
+    const char *newline = (const char *)memchr(*cursor, '\n', end - *cursor);
+
+    *cursor = (newline == NULL) ? end : newline + 1;
+}
+
+bool ParseInputFile(const char *filename, parsedInputStruct_t *inputStruct, bool verbose)
+{
+    int i, j, value, numObstructedCells, numNets, numNodesPerNet;
+    posStruct_t tempPos;
+    mappedFile_t inputFile;
+    const char *cursor, *end;
+    bool valid;
+
+    // Map the whole file and tokenize it in place, there's no need to copy it into lines and strings
+    if(!MapFile(filename, &inputFile))
+    {
+        printf("FATAL ERROR, file %s couldn't be opened!\n", filename);
+        return false;
+    }
+    printf("File %s opened!%s\n", filename, verbose ? " Here's what's in it:" : "");
+    cursor = inputFile.data;
+    end = inputFile.data + inputFile.size;
+    valid = true;
+
+    // 1. Get grid size (an optional third value is the number of routing layers)
+    valid = valid && ReadLineInt(&cursor, end, &value);
+    inputStruct->gridSizeX = value;
+    valid = valid && ReadLineInt(&cursor, end, &value);
+    inputStruct->gridSizeY = value;
+    inputStruct->gridSizeZ = 1;
+    if(valid && ReadLineInt(&cursor, end, &value))
+    {
+        inputStruct->gridSizeZ = value;
+    }
+    NextLine(&cursor, end);
+    if(valid)
+    {
+        printf("Grid size is %d x %d with %d layer(s)\n", inputStruct->gridSizeX, inputStruct->gridSizeY, inputStruct->gridSizeZ);
+    }
+
+    // 2. Determine the amount of obstructed cells
+    valid = valid && ReadLineInt(&cursor, end, &numObstructedCells);
+    NextLine(&cursor, end);
+    if(valid)
+    {
+        printf("%d obstructed cells in total%s\n", numObstructedCells, verbose ? ":" : "");
+        inputStruct->obstructions.reserve(inputStruct->obstructions.size() + numObstructedCells);
+    }
+
+    // 3. Get obstructed cell locations (an optional third value is the layer, otherwise the base layer is obstructed)
+    for(i = 0; valid && i < numObstructedCells; i++)
+    {
+        valid = ReadLineInt(&cursor, end, &value);
+        tempPos.posX = value;
+        valid = valid && ReadLineInt(&cursor, end, &value);
+        tempPos.posY = value;
+        tempPos.posZ = 0;
+        if(valid && ReadLineInt(&cursor, end, &value))
+        {
+            tempPos.posZ = value;
+        }
+        NextLine(&cursor, end);
+        inputStruct->obstructions.push_back(tempPos);
+        if(verbose)
+        {
+            printf("\t%d: %d, %d, %d\n", i, tempPos.posX, tempPos.posY, tempPos.posZ);
+        }
+    }
+
+    // 4. Get number of nets to route
+    valid = valid && ReadLineInt(&cursor, end, &numNets);
+    NextLine(&cursor, end);
+    if(valid)
+    {
+        printf("%d nets in total%s\n", numNets, verbose ? ":" : "");
+        inputStruct->nodes.reserve(inputStruct->nodes.size() + numNets);
+    }
+
+    // 5. Get nets to route
+    for(i = 0; valid && i < numNets; i++)
+    {
+        // 5.1. Get number of nodes for this net
+        valid = ReadLineInt(&cursor, end, &numNodesPerNet);
+        if(!valid)
+        {
+            break;
+        }
+        if(verbose)
+        {
+            printf("\t%d: %d nodes:\n", i, numNodesPerNet);
+        }
+        inputStruct->nodes.push_back(std::vector<posStruct_t>());
+        inputStruct->nodes.back().reserve(numNodesPerNet);
+        // 5.2. Iterate through net's nodes and add them (pins are always on the base layer)
+        for(j = 0; valid && j < numNodesPerNet; j++)
+        {
+            valid = ReadLineInt(&cursor, end, &value);
+            tempPos.posX = value;
+            valid = valid && ReadLineInt(&cursor, end, &value);
+            tempPos.posY = value;
+            tempPos.posZ = 0;
+            inputStruct->nodes.back().push_back(tempPos);
+            if(verbose)
+            {
+                printf("\t\t%d: %d, %d\n", j, tempPos.posX, tempPos.posY);
+            }
+        }
+        NextLine(&cursor, end);
+    }
+
+    UnmapFile(&inputFile);
+
+    if(!valid)
+    {
+        printf("FATAL ERROR, file %s couldn't be parsed!\n", filename);
+    }
+    return valid;
+}
+
+bool IsBinaryGridFile(const char *filename)
+{
+    FILE *inputFile;
+    unsigned int magic;
+    bool isBinary;
+
+    inputFile = fopen(filename, "rb");
+    if(inputFile == NULL)
+    {
+        return false;
+    }
+    isBinary = fread(&magic, sizeof(magic), 1, inputFile) == 1 && magic == BINARY_GRID_MAGIC;
+    fclose(inputFile);
+
+    return isBinary;
+}
+
+bool LoadBinaryGrid(const char *filename, parsedInputStruct_t *inputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, pin;
+    unsigned long long numCells, cell;
+    mappedFile_t inputFile;
+    binaryGridHeader_t header;
+    const unsigned char *obstructionBitmap;
+    const binaryGridNet_t *netTable;
+    const posStruct_t *pinTable;
+    const int *netPlane;
+    posStruct_t tempPos;
+
+    //1. Map the file and check the header and that every section fits inside it
+    if(!MapFile(filename, &inputFile))
+    {
+        printf("FATAL ERROR, file %s couldn't be opened!\n", filename);
+        return false;
+    }
+    if(inputFile.size < sizeof(header))
+    {
+        printf("FATAL ERROR, file %s is too short to be a binary grid!\n", filename);
+        UnmapFile(&inputFile);
+        return false;
+    }
+    memcpy(&header, inputFile.data, sizeof(header));
+    numCells = (unsigned long long)header.gridSizeX * header.gridSizeY * header.gridSizeZ;
+    if(header.magic != BINARY_GRID_MAGIC || header.version != BINARY_GRID_VERSION ||
+        header.obstructionOffset + (numCells + 7) / 8 > inputFile.size ||
+        header.netOffset + header.numNets * sizeof(binaryGridNet_t) > inputFile.size ||
+        header.pinOffset + header.numPins * sizeof(posStruct_t) > inputFile.size ||
+        (header.netPlaneOffset != 0 && header.netPlaneOffset + numCells * sizeof(int) > inputFile.size))
+    {
+        printf("FATAL ERROR, file %s isn't a valid version %d binary grid!\n", filename, BINARY_GRID_VERSION);
+        UnmapFile(&inputFile);
+        return false;
+    }
+    obstructionBitmap = (const unsigned char *)(inputFile.data + header.obstructionOffset);
+    netTable = (const binaryGridNet_t *)(inputFile.data + header.netOffset);
+    pinTable = (const posStruct_t *)(inputFile.data + header.pinOffset);
+    printf("Binary grid %s opened!\n", filename);
+
+    //2. Get grid size
+    inputStruct->gridSizeX = header.gridSizeX;
+    inputStruct->gridSizeY = header.gridSizeY;
+    inputStruct->gridSizeZ = header.gridSizeZ;
+    printf("Grid size is %d x %d with %d layer(s)\n", inputStruct->gridSizeX, inputStruct->gridSizeY, inputStruct->gridSizeZ);
+
+    //3. Unpack the obstruction bitmap a row at a time, skipping over empty bytes
+    cell = 0;
+    for(tempPos.posZ = 0; tempPos.posZ < header.gridSizeZ; tempPos.posZ++)
+    {
+        for(tempPos.posY = 0; tempPos.posY < header.gridSizeY; tempPos.posY++)
+        {
+            for(tempPos.posX = 0; tempPos.posX < header.gridSizeX; tempPos.posX++, cell++)
+            {
+                // Jump over the rest of an empty byte in one go (as long as it doesn't run past the end of the row)
+                if(cell % 8 == 0 && obstructionBitmap[cell / 8] == 0 && tempPos.posX + 8 <= header.gridSizeX)
+                {
+                    tempPos.posX += 7;
+                    cell += 7;
+                    continue;
+                }
+                if(obstructionBitmap[cell / 8] & (1 << (cell % 8)))
+                {
+                    inputStruct->obstructions.push_back(tempPos);
+                }
+            }
+        }
+    }
+    printf("%d obstructed cells in total\n", (int)inputStruct->obstructions.size());
+
+    //4. Get nets to route from the net and pin tables
+    inputStruct->nodes.reserve(inputStruct->nodes.size() + header.numNets);
+    pin = 0;
+    for(i = 0; i < header.numNets; i++)
+    {
+        if(pin + netTable[i].numPins > header.numPins)
+        {
+            printf("FATAL ERROR, file %s has more pins in its nets than in its pin table!\n", filename);
+            UnmapFile(&inputFile);
+            return false;
+        }
+        inputStruct->nodes.push_back(std::vector<posStruct_t>(pinTable + pin, pinTable + pin + netTable[i].numPins));
+        pin += netTable[i].numPins;
+    }
+
+    // The pins go straight to GetCell, so every one of them has to be on the grid
+    for(pin = 0; pin < header.numPins; pin++)
+    {
+        if(pinTable[pin].posX >= header.gridSizeX || pinTable[pin].posY >= header.gridSizeY || pinTable[pin].posZ >= header.gridSizeZ)
+        {
+            printf("FATAL ERROR, file %s has a pin at %d, %d, %d outside of the grid!\n", filename, pinTable[pin].posX, pinTable[pin].posY, pinTable[pin].posZ);
+            UnmapFile(&inputFile);
+            return false;
+        }
+    }
+    printf("%d nets in total\n", header.numNets);
+
+    //5. Keep the routing, if the grid has one, to restore once the cells are populated
+    gridStruct->savedRouting.netPlane.clear();
+    gridStruct->savedRouting.netPins.clear();
+    gridStruct->savedRouting.netRouted.clear();
+    if(header.netPlaneOffset != 0)
+    {
+        netPlane = (const int *)(inputFile.data + header.netPlaneOffset);
+        gridStruct->savedRouting.netPlane.assign(netPlane, netPlane + numCells);
+        pin = 0;
+        for(i = 0; i < header.numNets; i++)
+        {
+            // Nets without pins can't be found again, and have nothing to restore anyway
+            tempPos.posX = tempPos.posY = tempPos.posZ = 0;
+            if(netTable[i].numPins > 0)
+            {
+                tempPos = pinTable[pin];
+            }
+            gridStruct->savedRouting.netPins.push_back(tempPos);
+            gridStruct->savedRouting.netRouted.push_back(netTable[i].routed != 0 && netTable[i].numPins > 0);
+            pin += netTable[i].numPins;
+        }
+        printf("%d of %d nets were routed when the grid was saved\n", header.netsRouted, header.numNets);
+    }
+
+    UnmapFile(&inputFile);
+
+    return true;
+}
+
+bool SaveBinaryGrid(const char *filename, parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, j, x, y, z;
+    unsigned long long numCells, cell, offset;
+    binaryGridHeader_t header;
+    binaryGridNet_t tempNet;
+    std::vector<unsigned char> obstructionBitmap;
+    std::vector<binaryGridNet_t> netTable;
+    std::vector<posStruct_t> pinTable;
+    std::vector<int> netPlane, fileIds;
+    cellStruct_t *currentCell;
+    FILE *outputFile;
+    bool written;
+
+    numCells = (unsigned long long)parsedInputStruct->gridSizeX * parsedInputStruct->gridSizeY * parsedInputStruct->gridSizeZ;
+
+    //1. Pack the obstructions one bit per cell
+    obstructionBitmap.assign((numCells + 7) / 8, 0);
+    for(i = 0; i < parsedInputStruct->obstructions.size(); i++)
+    {
+        cell = ((unsigned long long)parsedInputStruct->obstructions[i].posZ * parsedInputStruct->gridSizeY + parsedInputStruct->obstructions[i].posY) * parsedInputStruct->gridSizeX + parsedInputStruct->obstructions[i].posX;
+        obstructionBitmap[cell / 8] |= 1 << (cell % 8);
+    }
+
+    //2. Fill in the net and pin tables, a net is routed once none of its pins are left unconnected
+    header.netsRouted = 0;
+    if(gridStruct != NULL)
+    {
+        fileIds.assign(parsedInputStruct->nodes.size(), -1);
+    }
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        tempNet.numPins = parsedInputStruct->nodes[i].size();
+        tempNet.routed = 0;
+        if(gridStruct != NULL)
+        {
+            tempNet.routed = 1;
+            for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+            {
+                currentCell = GetCell(gridStruct, parsedInputStruct->nodes[i][j].posX, parsedInputStruct->nodes[i][j].posY, parsedInputStruct->nodes[i][j].posZ);
+                if(currentCell->currentCellProp == CELL_NET_SINK_UNCONN)
+                {
+                    tempNet.routed = 0;
+                }
+                // The cells may come from an earlier attempt with another net order, so map their ids through the pins
+                if(GetCellNet(currentCell) >= 0 && (unsigned int)GetCellNet(currentCell) < fileIds.size())
+                {
+                    fileIds[GetCellNet(currentCell)] = i;
+                }
+            }
+        }
+        header.netsRouted += tempNet.routed;
+        netTable.push_back(tempNet);
+        pinTable.insert(pinTable.end(), parsedInputStruct->nodes[i].begin(), parsedInputStruct->nodes[i].end());
+    }
+
+    //3. Record every cell's net, keeping only the wires of routed nets
+    if(gridStruct != NULL)
+    {
+        netPlane.assign(numCells, -1);
+        cell = 0;
+        for(z = 0; z < parsedInputStruct->gridSizeZ; z++)
+        {
+            for(y = 0; y < parsedInputStruct->gridSizeY; y++)
+            {
+                for(x = 0; x < parsedInputStruct->gridSizeX; x++, cell++)
+                {
+                    currentCell = GetCell(gridStruct, x, y, z);
+                    if(GetCellNet(currentCell) < 0 || fileIds[GetCellNet(currentCell)] < 0)
+                    {
+                        continue;
+                    }
+                    if((currentCell->currentCellProp == CELL_NET_WIRE_CONN || currentCell->currentCellProp == CELL_NET_WIRE_UNCONN) &&
+                        !netTable[fileIds[GetCellNet(currentCell)]].routed)
+                    {
+                        continue;
+                    }
+                    netPlane[cell] = fileIds[GetCellNet(currentCell)];
+                }
+            }
+        }
+    }
+
+    //4. Lay out the header and sections, each section starting on an 8 byte boundary
+    header.magic = BINARY_GRID_MAGIC;
+    header.version = BINARY_GRID_VERSION;
+    header.gridSizeX = parsedInputStruct->gridSizeX;
+    header.gridSizeY = parsedInputStruct->gridSizeY;
+    header.gridSizeZ = parsedInputStruct->gridSizeZ;
+    header.numNets = netTable.size();
+    header.numPins = pinTable.size();
+    offset = sizeof(header);
+    header.obstructionOffset = offset;
+    offset = (offset + obstructionBitmap.size() + 7) & ~7ULL;
+    header.netOffset = offset;
+    offset = (offset + netTable.size() * sizeof(binaryGridNet_t) + 7) & ~7ULL;
+    header.pinOffset = offset;
+    offset = (offset + pinTable.size() * sizeof(posStruct_t) + 7) & ~7ULL;
+    header.netPlaneOffset = netPlane.empty() ? 0 : offset;
+
+    //5. Write it all out
+    outputFile = fopen(filename, "wb");
+    if(outputFile == NULL)
+    {
+        printf("ERROR, file %s couldn't be opened for writing!\n", filename);
+        return false;
+    }
+    written = WriteSection(outputFile, 0, &header, sizeof(header)) &&
+        WriteSection(outputFile, header.obstructionOffset, obstructionBitmap.data(), obstructionBitmap.size()) &&
+        WriteSection(outputFile, header.netOffset, netTable.data(), netTable.size() * sizeof(binaryGridNet_t)) &&
+        WriteSection(outputFile, header.pinOffset, pinTable.data(), pinTable.size() * sizeof(posStruct_t)) &&
+        (netPlane.empty() || WriteSection(outputFile, header.netPlaneOffset, netPlane.data(), netPlane.size() * sizeof(int)));
+    written = (fclose(outputFile) == 0) && written;
+    if(!written)
+    {
+        printf("ERROR, couldn't write binary grid %s!\n", filename);
+        return false;
+    }
+    printf("Saved binary grid %s (%d of %d nets routed)\n", filename, header.netsRouted, header.numNets);
+
+    return true;
+}
+
+bool WriteSection(FILE *outputFile, unsigned long long offset, const void *data, size_t size)
+{
+    long position;
+
+    // Pad up to where the section starts
+    position = ftell(outputFile);
+    while(position >= 0 && (unsigned long long)position < offset)
+    {
+        if(fputc(0, outputFile) == EOF)
+        {
+            return false;
+        }
+        position++;
+    }
+    return size == 0 || fwrite(data, size, 1, outputFile) == 1;
+}
+
+bool RestoreSavedRouting(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, j, x, y, z, numRestored;
+    unsigned long long cell;
+    std::vector<int> currentIds, newIds;
+    std::vector<bool> routed;
+    std::vector<std::vector<posStruct_t>> newNodes;
+    std::vector<unsigned int> newRoutedNodes;
+    cellStruct_t *currentCell;
+
+    if(gridStruct->savedRouting.netPlane.empty())
+    {
+        return false;
+    }
+    if(gridStruct->savedRouting.netPlane.size() != (unsigned long long)gridStruct->gridSizeX * gridStruct->gridSizeY * gridStruct->gridSizeZ ||
+        gridStruct->savedRouting.netPins.size() != parsedInputStruct->nodes.size())
+    {
+        printf("Saved routing doesn't match the grid anymore, routing from scratch\n");
+        return false;
+    }
+
+    //1. The nets have been shuffled since the grid was saved, find each saved net's current id from one of its pins
+    currentIds.assign(gridStruct->savedRouting.netPins.size(), -1);
+    routed.assign(parsedInputStruct->nodes.size(), false);
+    for(i = 0; i < gridStruct->savedRouting.netPins.size(); i++)
+    {
+        if(!gridStruct->savedRouting.netRouted[i])
+        {
+            continue;
+        }
+        currentCell = GetCell(gridStruct, gridStruct->savedRouting.netPins[i].posX, gridStruct->savedRouting.netPins[i].posY, gridStruct->savedRouting.netPins[i].posZ);
+        currentIds[i] = GetCellNet(currentCell);
+        routed[GetCellNet(currentCell)] = true;
+    }
+
+    //2. Work out the new net order: the restored nets, then the ones left to route
+    newIds.assign(parsedInputStruct->nodes.size(), -1);
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        if(routed[i])
+        {
+            newIds[i] = newNodes.size();
+            newNodes.push_back(parsedInputStruct->nodes[i]);
+            newRoutedNodes.push_back(0);
+        }
+    }
+    numRestored = newNodes.size();
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        if(!routed[i])
+        {
+            newIds[i] = newNodes.size();
+            newNodes.push_back(parsedInputStruct->nodes[i]);
+            newRoutedNodes.push_back(gridStruct->netRoutedNodes[i]);
+        }
+    }
+    parsedInputStruct->nodes = newNodes;
+    gridStruct->netRoutedNodes = newRoutedNodes;
+
+    //3. Renumber the pins and connect the restored nets' pins
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+        {
+            currentCell = GetCell(gridStruct, parsedInputStruct->nodes[i][j].posX, parsedInputStruct->nodes[i][j].posY, parsedInputStruct->nodes[i][j].posZ);
+            SetCellNet(gridStruct, currentCell, i);
+            if(i < numRestored && currentCell->currentCellProp == CELL_NET_SINK_UNCONN)
+            {
+                SetCellProp(gridStruct, currentCell, CELL_NET_SINK_CONN);
+            }
+        }
+    }
+
+    //4. Lay the restored nets' wires back down
+    cell = 0;
+    for(z = 0; z < gridStruct->gridSizeZ; z++)
+    {
+        for(y = 0; y < gridStruct->gridSizeY; y++)
+        {
+            for(x = 0; x < gridStruct->gridSizeX; x++, cell++)
+            {
+                if(gridStruct->savedRouting.netPlane[cell] < 0 ||
+                    (unsigned int)gridStruct->savedRouting.netPlane[cell] >= currentIds.size() ||
+                    currentIds[gridStruct->savedRouting.netPlane[cell]] < 0)
+                {
+                    continue;
+                }
+                currentCell = GetCell(gridStruct, x, y, z);
+                if(currentCell->currentCellProp == CELL_EMPTY)
+                {
+                    SetCellNet(gridStruct, currentCell, newIds[currentIds[gridStruct->savedRouting.netPlane[cell]]]);
+                    SetCellProp(gridStruct, currentCell, CELL_NET_WIRE_CONN);
+                }
+            }
+        }
+    }
+
+    //5. Carry on routing after the restored nets
+    gridStruct->currentNet = numRestored;
+    if(numRestored > gridStruct->bestNetsRouted)
+    {
+        gridStruct->bestNetsRouted = numRestored;
+        SaveBestGrid(gridStruct);
+    }
+    if(numRestored == parsedInputStruct->nodes.size())
+    {
+        gridStruct->currentRoutingState = STATE_ROUTE_SUCCESS;
+    }
+    // Retries restore the same nets again, only say so the first time unless we're verbose
+    if(gridStruct->currentRetries == 0 || gridStruct->verbose)
+    {
+        printf("Restored %d routed net(s) from the saved routing\n", numRestored);
+    }
+
+    return true;
+}
+
+bool ReadLineWord(const char **cursor, const char *end, std::string *word)
+{
+    const char *current = *cursor;
+    const char *start;
+
+    // Skip the separators before the word, but never past the end of the line
+    while(current < end && (*current == ' ' || *current == '\t' || *current == '\r'))
+    {
+        current++;
+    }
+    start = current;
+    while(current < end && *current != ' ' && *current != '\t' && *current != '\r' && *current != '\n')
+    {
+        current++;
+    }
+
+    word->assign(start, current - start);
+    *cursor = current;
+    return !word->empty();
+}
+
+int FindNetByPin(parsedInputStruct_t *parsedInputStruct, posStruct_t *pin)
+{
+    unsigned int i, j;
+
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+        {
+            if(parsedInputStruct->nodes[i][j].posX == pin->posX &&
+                parsedInputStruct->nodes[i][j].posY == pin->posY &&
+                parsedInputStruct->nodes[i][j].posZ == pin->posZ)
+            {
+                return i;
+            }
+        }
+    }
+    return -1;
+}
+
+bool ApplyRoutingDelta(const char *filename, parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, j, lineNumber, numAdded, numRemoved, numObstructed;
+    int value, net, numPins;
+    unsigned long long cell;
+    mappedFile_t deltaFile;
+    const char *cursor, *end;
+    std::string command;
+    std::vector<posStruct_t> tempNet;
+    std::vector<bool> ripped;
+    posStruct_t tempPos;
+    bool valid, skip;
+
+    if(!MapFile(filename, &deltaFile))
+    {
+        printf("FATAL ERROR, delta file %s couldn't be opened!\n", filename);
+        return false;
+    }
+    cursor = deltaFile.data;
+    end = deltaFile.data + deltaFile.size;
+    valid = true;
+    numAdded = numRemoved = numObstructed = 0;
+    ripped.assign(parsedInputStruct->nodes.size(), false);
+    if(gridStruct->savedRouting.netPlane.empty())
+    {
+        printf("No saved routing to apply delta %s to, every net will be routed\n", filename);
+    }
+
+    for(lineNumber = 1; valid && cursor < end; lineNumber++, NextLine(&cursor, end))
+    {
+        // Skip blank lines and comments
+        if(!ReadLineWord(&cursor, end, &command) || command[0] == '#')
+        {
+            continue;
+        }
+
+        // obstruct x y [z]: a new obstruction, ripping up the saved net routed through it
+        if(command == "obstruct")
+        {
+            valid = ReadLineInt(&cursor, end, &value);
+            tempPos.posX = value;
+            valid = valid && ReadLineInt(&cursor, end, &value);
+            tempPos.posY = value;
+            tempPos.posZ = 0;
+            if(valid && ReadLineInt(&cursor, end, &value))
+            {
+                tempPos.posZ = value;
+            }
+            if(!valid || tempPos.posX >= parsedInputStruct->gridSizeX || tempPos.posY >= parsedInputStruct->gridSizeY || tempPos.posZ >= parsedInputStruct->gridSizeZ)
+            {
+                valid = false;
+                break;
+            }
+            if(FindNetByPin(parsedInputStruct, &tempPos) >= 0)
+            {
+                printf("Delta line %d: can't obstruct the pin at %d, %d, %d, skipping it\n", lineNumber, tempPos.posX, tempPos.posY, tempPos.posZ);
+                continue;
+            }
+            if(!gridStruct->savedRouting.netPlane.empty())
+            {
+                cell = ((unsigned long long)tempPos.posZ * parsedInputStruct->gridSizeY + tempPos.posY) * parsedInputStruct->gridSizeX + tempPos.posX;
+                net = gridStruct->savedRouting.netPlane[cell];
+                if(net >= 0)
+                {
+                    ripped[net] = true;
+                    gridStruct->savedRouting.netPlane[cell] = -1;
+                }
+            }
+            parsedInputStruct->obstructions.push_back(tempPos);
+            numObstructed++;
+        }
+        // add n x0 y0 x1 y1 ...: a new net, ripping up the saved nets routed through its pins
+        else if(command == "add")
+        {
+            valid = ReadLineInt(&cursor, end, &numPins) && numPins > 0;
+            tempNet.clear();
+            skip = false;
+            for(j = 0; valid && j < (unsigned int)numPins; j++)
+            {
+                valid = ReadLineInt(&cursor, end, &value);
+                tempPos.posX = value;
+                valid = valid && ReadLineInt(&cursor, end, &value);
+                tempPos.posY = value;
+                tempPos.posZ = 0;
+                valid = valid && tempPos.posX < parsedInputStruct->gridSizeX && tempPos.posY < parsedInputStruct->gridSizeY;
+                if(valid && FindNetByPin(parsedInputStruct, &tempPos) >= 0)
+                {
+                    printf("Delta line %d: pin %d, %d already belongs to a net, skipping the new net\n", lineNumber, tempPos.posX, tempPos.posY);
+                    skip = true;
+                }
+                for(i = 0; valid && i < parsedInputStruct->obstructions.size(); i++)
+                {
+                    if(parsedInputStruct->obstructions[i].posX == tempPos.posX && parsedInputStruct->obstructions[i].posY == tempPos.posY && parsedInputStruct->obstructions[i].posZ == tempPos.posZ)
+                    {
+                        printf("Delta line %d: pin %d, %d is obstructed, skipping the new net\n", lineNumber, tempPos.posX, tempPos.posY);
+                        skip = true;
+                    }
+                }
+                tempNet.push_back(tempPos);
+            }
+            if(!valid)
+            {
+                break;
+            }
+            if(skip)
+            {
+                continue;
+            }
+            for(j = 0; j < tempNet.size() && !gridStruct->savedRouting.netPlane.empty(); j++)
+            {
+                cell = ((unsigned long long)tempNet[j].posZ * parsedInputStruct->gridSizeY + tempNet[j].posY) * parsedInputStruct->gridSizeX + tempNet[j].posX;
+                net = gridStruct->savedRouting.netPlane[cell];
+                if(net >= 0)
+                {
+                    ripped[net] = true;
+                    gridStruct->savedRouting.netPlane[cell] = -1;
+                }
+            }
+            parsedInputStruct->nodes.push_back(tempNet);
+            ripped.push_back(false);
+            if(!gridStruct->savedRouting.netPlane.empty())
+            {
+                gridStruct->savedRouting.netPins.push_back(tempNet[0]);
+                gridStruct->savedRouting.netRouted.push_back(false);
+            }
+            numAdded++;
+        }
+        // remove x y: remove the net with a pin at x, y along with its saved route
+        else if(command == "remove")
+        {
+            valid = ReadLineInt(&cursor, end, &value);
+            tempPos.posX = value;
+            valid = valid && ReadLineInt(&cursor, end, &value);
+            tempPos.posY = value;
+            tempPos.posZ = 0;
+            if(!valid)
+            {
+                break;
+            }
+            net = FindNetByPin(parsedInputStruct, &tempPos);
+            if(net < 0)
+            {
+                printf("Delta line %d: no net has a pin at %d, %d, skipping it\n", lineNumber, tempPos.posX, tempPos.posY);
+                continue;
+            }
+            parsedInputStruct->nodes.erase(parsedInputStruct->nodes.begin() + net);
+            ripped.erase(ripped.begin() + net);
+            if(!gridStruct->savedRouting.netPlane.empty())
+            {
+                gridStruct->savedRouting.netPins.erase(gridStruct->savedRouting.netPins.begin() + net);
+                gridStruct->savedRouting.netRouted.erase(gridStruct->savedRouting.netRouted.begin() + net);
+                // Clear the removed net out of the plane and shift the nets after it down
+                for(cell = 0; cell < gridStruct->savedRouting.netPlane.size(); cell++)
+                {
+                    if(gridStruct->savedRouting.netPlane[cell] == net)
+                    {
+                        gridStruct->savedRouting.netPlane[cell] = -1;
+                    }
+                    else if(gridStruct->savedRouting.netPlane[cell] > net)
+                    {
+                        gridStruct->savedRouting.netPlane[cell]--;
+                    }
+                }
+            }
+            numRemoved++;
+        }
+        else
+        {
+            valid = false;
+            break;
+        }
+    }
+    UnmapFile(&deltaFile);
+
+    if(!valid)
+    {
+        printf("FATAL ERROR, delta file %s couldn't be parsed at line %d!\n", filename, lineNumber);
+        return false;
+    }
+
+    // Only the nets the delta ran into have to be routed again, the rest are restored as they were
+    j = 0;
+    for(i = 0; i < ripped.size() && !gridStruct->savedRouting.netPlane.empty(); i++)
+    {
+        if(ripped[i] && gridStruct->savedRouting.netRouted[i])
+        {
+            gridStruct->savedRouting.netRouted[i] = false;
+            j++;
+        }
+    }
+    printf("Applied delta %s: %d net(s) added, %d removed, %d new obstruction(s), %d net(s) ripped up\n", filename, numAdded, numRemoved, numObstructed, j);
+
+    return true;
+}
+
+void BeginNetTelemetry(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    // The counters are cheap enough to always keep, only the timers and the records depend on whether we're recording
+    gridStruct->currentTelemetry = netTelemetry_t();
+    gridStruct->currentTelemetry.net = gridStruct->currentNet;
+    gridStruct->currentTelemetry.source = parsedInputStruct->nodes[gridStruct->currentNet][0];
+    gridStruct->currentTelemetry.pins = parsedInputStruct->nodes[gridStruct->currentNet].size();
+    gridStruct->currentTelemetry.attempt = gridStruct->currentRetries;
+    gridStruct->currentTelemetry.active = !gridStruct->telemetryFilename.empty();
+    if(gridStruct->currentTelemetry.active)
+    {
+        gridStruct->currentTelemetry.startTime = std::chrono::steady_clock::now();
+        gridStruct->currentTelemetry.startClock = std::clock();
+    }
+}
+
+void EndNetTelemetry(gridStruct_t *gridStruct, bool routed)
+{
+    // Only record each net once, failures can be seen more than once on their way out
+    if(!gridStruct->currentTelemetry.active)
+    {
+        return;
+    }
+    gridStruct->currentTelemetry.active = false;
+    gridStruct->currentTelemetry.routed = routed;
+    gridStruct->currentTelemetry.wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - gridStruct->currentTelemetry.startTime).count();
+    gridStruct->currentTelemetry.cpuTime = (double)(std::clock() - gridStruct->currentTelemetry.startClock) / CLOCKS_PER_SEC;
+    gridStruct->telemetry.push_back(gridStruct->currentTelemetry);
+}
+
+bool WriteTelemetry(const char *filename, gridStruct_t *gridStruct)
+{
+    unsigned int i;
+    size_t length;
+    bool json;
+    FILE *outputFile;
+    netTelemetry_t *record;
+
+    outputFile = fopen(filename, "w");
+    if(outputFile == NULL)
+    {
+        printf("ERROR, file %s couldn't be opened for writing!\n", filename);
+        return false;
+    }
+
+    // Files ending in .json get JSON, anything else gets CSV
+    length = strlen(filename);
+    json = length >= 5 && strcmp(filename + length - 5, ".json") == 0;
+
+    if(json)
+    {
+        fprintf(outputFile, "{\n  \"router\": \"%s\",\n  \"attempts\": %u,\n  \"routed\": %s,\n  \"nets\": [\n",
+            gridStruct->engine->name, gridStruct->currentRetries + 1, gridStruct->currentRoutingState == STATE_ROUTE_SUCCESS ? "true" : "false");
+    }
+    else
+    {
+        fprintf(outputFile, "net,sourceX,sourceY,sourceZ,pins,attempt,routed,cellsExpanded,expansionLayers,frontierPeak,walkbackLength,wallSeconds,cpuSeconds\n");
+    }
+    for(i = 0; i < gridStruct->telemetry.size(); i++)
+    {
+        record = &gridStruct->telemetry[i];
+        if(json)
+        {
+            fprintf(outputFile, "    {\"net\": %u, \"source\": [%u, %u, %u], \"pins\": %u, \"attempt\": %u, \"routed\": %s, "
+                "\"cellsExpanded\": %llu, \"expansionLayers\": %u, \"frontierPeak\": %llu, \"walkbackLength\": %u, "
+                "\"wallSeconds\": %.6f, \"cpuSeconds\": %.6f}%s\n",
+                record->net, record->source.posX, record->source.posY, record->source.posZ, record->pins, record->attempt, record->routed ? "true" : "false",
+                record->cellsExpanded, record->expansionLayers, record->frontierPeak, record->walkbackLength,
+                record->wallTime, record->cpuTime, (i + 1 < gridStruct->telemetry.size()) ? "," : "");
+        }
+        else
+        {
+            fprintf(outputFile, "%u,%u,%u,%u,%u,%u,%d,%llu,%u,%llu,%u,%.6f,%.6f\n",
+                record->net, record->source.posX, record->source.posY, record->source.posZ, record->pins, record->attempt, record->routed ? 1 : 0,
+                record->cellsExpanded, record->expansionLayers, record->frontierPeak, record->walkbackLength,
+                record->wallTime, record->cpuTime);
+        }
+    }
+    if(json)
+    {
+        fprintf(outputFile, "  ]\n}\n");
+    }
+
+    if(fclose(outputFile) != 0)
+    {
+        printf("ERROR, couldn't write telemetry %s!\n", filename);
+        return false;
+    }
+    printf("Saved telemetry for %d net attempt(s) to %s\n", (int)gridStruct->telemetry.size(), filename);
+
+    return true;
+}
+
+bool WriteGridImage(const char *filename, gridStruct_t *gridStruct, unsigned int cellPixels)
+{
+    size_t length;
+    unsigned int width, height;
+    std::vector<unsigned char> pixels;
+    bool written;
+
+    // Files ending in .ps get PostScript, .png get PNG, anything else gets PPM
+    length = strlen(filename);
+    if(length >= 3 && strcmp(filename + length - 3, ".ps") == 0)
+    {
+        return WriteGridPostScript(filename, gridStruct);
+    }
+
+    // Draw the layers side by side, a cell apart
+    width = (gridStruct->gridSizeZ * (gridStruct->gridSizeX + 1) - 1) * cellPixels;
+    height = gridStruct->gridSizeY * cellPixels;
+    RenderGridImage(gridStruct, cellPixels, &pixels);
+
+    if(length >= 4 && strcmp(filename + length - 4, ".png") == 0)
+    {
+        written = WritePng(filename, width, height, &pixels);
+    }
+    else
+    {
+        written = WritePpm(filename, width, height, &pixels);
+    }
+    if(written)
+    {
+        printf("Saved a %u x %u image of the grid to %s\n", width, height, filename);
+    }
+    return written;
+}
+
+void RenderGridImage(gridStruct_t *gridStruct, unsigned int cellPixels, std::vector<unsigned char> *pixels)
+{
+    unsigned int x, y, z, px, py, width;
+    size_t offset;
+    cellStruct_t *cell;
+    const unsigned char *color;
+    bool pin, outline;
+
+    width = (gridStruct->gridSizeZ * (gridStruct->gridSizeX + 1) - 1) * cellPixels;
+    pixels->assign((size_t)width * gridStruct->gridSizeY * cellPixels * 3, 0);
+    // Outlines only help when cells are big enough to see them, like on screen
+    outline = cellPixels >= LOD_MIN_OUTLINE_PIXELS;
+
+    for(z = 0; z < gridStruct->gridSizeZ; z++)
+    {
+        for(y = 0; y < gridStruct->gridSizeY; y++)
+        {
+            for(x = 0; x < gridStruct->gridSizeX; x++)
+            {
+                cell = GetCell(gridStruct, x, y, z);
+                pin = false;
+                switch(cell->currentCellProp)
+                {
+                    case CELL_OBSTRUCTED:
+                        color = imageColors[OBSTRUCTION_COLOR];
+                        break;
+                    case CELL_NET_SOURCE:
+                    case CELL_NET_SINK_UNCONN:
+                    case CELL_NET_SINK_CONN:
+                        pin = true;
+                        color = imageColors[netColors[GetCellNet(cell) & 7]];
+                        break;
+                    case CELL_NET_WIRE_UNCONN:
+                    case CELL_NET_WIRE_CONN:
+                        color = imageColors[netColors[GetCellNet(cell) & 7]];
+                        break;
+                    default:
+                        color = imageColors[BACKGROUND_COLOR];
+                        break;
+                }
+
+                // Fill in the cell's block of pixels
+                for(py = 0; py < cellPixels; py++)
+                {
+                    offset = (((size_t)y * cellPixels + py) * width + ((size_t)z * (gridStruct->gridSizeX + 1) + x) * cellPixels) * 3;
+                    for(px = 0; px < cellPixels; px++, offset += 3)
+                    {
+                        // Pins get a white centre, when there's a centre to colour
+                        if(pin && cellPixels >= 3 && px == cellPixels / 2 && py == cellPixels / 2)
+                        {
+                            memcpy(&(*pixels)[offset], imageColors[WHITE], 3);
+                        }
+                        else if(outline && color == imageColors[BACKGROUND_COLOR] && (px == 0 || py == 0))
+                        {
+                            memcpy(&(*pixels)[offset], imageColors[GRID_COLOR], 3);
+                        }
+                        else
+                        {
+                            memcpy(&(*pixels)[offset], color, 3);
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+bool WritePpm(const char *filename, unsigned int width, unsigned int height, std::vector<unsigned char> *pixels)
+{
+    FILE *outputFile;
+    bool written;
+
+    outputFile = fopen(filename, "wb");
+    if(outputFile == NULL)
+    {
+        printf("ERROR, file %s couldn't be opened for writing!\n", filename);
+        return false;
+    }
+
+    // Binary PPM, a short text header followed by raw RGB rows
+    written = fprintf(outputFile, "P6\n%u %u\n255\n", width, height) > 0;
+    written = written && fwrite(pixels->data(), 1, pixels->size(), outputFile) == pixels->size();
+    if(fclose(outputFile) != 0 || !written)
+    {
+        printf("ERROR, couldn't write image %s!\n", filename);
+        return false;
+    }
+    return true;
+}
+
+bool WritePng(const char *filename, unsigned int width, unsigned int height, std::vector<unsigned char> *pixels)
+{
+    FILE *outputFile;
+    bool written;
+    unsigned int y, adlerA, adlerB, blockSize;
+    size_t i, rowSize;
+    std::vector<unsigned char> raw;
+    std::vector<unsigned char> data;
+    unsigned char header[13];
+
+    outputFile = fopen(filename, "wb");
+    if(outputFile == NULL)
+    {
+        printf("ERROR, file %s couldn't be opened for writing!\n", filename);
+        return false;
+    }
+
+    //1. Every row starts with its filter type, we never filter
+    rowSize = (size_t)width * 3;
+    raw.resize((rowSize + 1) * height);
+    for(y = 0; y < height; y++)
+    {
+        raw[y * (rowSize + 1)] = 0;
+        memcpy(&raw[y * (rowSize + 1) + 1], &(*pixels)[y * rowSize], rowSize);
+    }
+
+    //2. Wrap the rows in a zlib stream made of stored (uncompressed) deflate blocks, so we don't need zlib itself
+    data.reserve(raw.size() + (raw.size() / PNG_STORED_BLOCK_SIZE + 1) * 5 + 6);
+    data.push_back(0x78);
+    data.push_back(0x01);
+    i = 0;
+    do
+    {
+        blockSize = (unsigned int)std::min(raw.size() - i, (size_t)PNG_STORED_BLOCK_SIZE);
+        data.push_back(i + blockSize == raw.size() ? 1 : 0);
+        data.push_back(blockSize & 0xFF);
+        data.push_back(blockSize >> 8);
+        data.push_back(~blockSize & 0xFF);
+        data.push_back((~blockSize >> 8) & 0xFF);
+        data.insert(data.end(), raw.begin() + i, raw.begin() + i + blockSize);
+        i += blockSize;
+    } while(i < raw.size());
+    adlerA = 1;
+    adlerB = 0;
+    for(i = 0; i < raw.size(); i++)
+    {
+        adlerA = (adlerA + raw[i]) % 65521;
+        adlerB = (adlerB + adlerA) % 65521;
+    }
+    data.push_back(adlerB >> 8);
+    data.push_back(adlerB & 0xFF);
+    data.push_back(adlerA >> 8);
+    data.push_back(adlerA & 0xFF);
+
+    //3. Signature, 8 bit RGB header, the image data and the end marker
+    header[0] = width >> 24; header[1] = (width >> 16) & 0xFF; header[2] = (width >> 8) & 0xFF; header[3] = width & 0xFF;
+    header[4] = height >> 24; header[5] = (height >> 16) & 0xFF; header[6] = (height >> 8) & 0xFF; header[7] = height & 0xFF;
+    header[8] = 8;
+    header[9] = 2;
+    header[10] = 0;
+    header[11] = 0;
+    header[12] = 0;
+    written = fwrite("\x89PNG\r\n\x1a\n", 1, 8, outputFile) == 8;
+    written = written && WritePngChunk(outputFile, "IHDR", header, sizeof(header));
+    written = written && WritePngChunk(outputFile, "IDAT", data.data(), (unsigned int)data.size());
+    written = written && WritePngChunk(outputFile, "IEND", NULL, 0);
+
+    if(fclose(outputFile) != 0 || !written)
+    {
+        printf("ERROR, couldn't write image %s!\n", filename);
+        return false;
+    }
+    return true;
+}
+
+bool WritePngChunk(FILE *outputFile, const char *type, const unsigned char *data, unsigned int size)
+{
+    static const std::vector<unsigned int> crcTable = MakeCrcTable();
+    unsigned int i, crc;
+    unsigned char bytes[4];
+
+    // The length, then the type and data which the CRC covers
+    bytes[0] = size >> 24; bytes[1] = (size >> 16) & 0xFF; bytes[2] = (size >> 8) & 0xFF; bytes[3] = size & 0xFF;
+    if(fwrite(bytes, 1, 4, outputFile) != 4 || fwrite(type, 1, 4, outputFile) != 4 ||
+        (size > 0 && fwrite(data, 1, size, outputFile) != size))
+    {
+        return false;
+    }
+    crc = 0xFFFFFFFF;
+    for(i = 0; i < 4; i++)
+    {
+        crc = crcTable[(crc ^ (unsigned char)type[i]) & 0xFF] ^ (crc >> 8);
+    }
+    for(i = 0; i < size; i++)
+    {
+        crc = crcTable[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    crc ^= 0xFFFFFFFF;
+    bytes[0] = crc >> 24; bytes[1] = (crc >> 16) & 0xFF; bytes[2] = (crc >> 8) & 0xFF; bytes[3] = crc & 0xFF;
+    return fwrite(bytes, 1, 4, outputFile) == 4;
+}
+
+std::vector<unsigned int> MakeCrcTable(void)
+{
+    unsigned int i, j, crc;
+    std::vector<unsigned int> crcTable(256);
+
+    // The CRC-32 of every byte value, as PNG chunks use
+    for(i = 0; i < 256; i++)
+    {
+        crc = i;
+        for(j = 0; j < 8; j++)
+        {
+            crc = (crc & 1) ? 0xEDB88320 ^ (crc >> 1) : crc >> 1;
+        }
+        crcTable[i] = crc;
+    }
+    return crcTable;
+}
+
+bool WriteGridPostScript(const char *filename, gridStruct_t *gridStruct)
+{
+    FILE *outputFile;
+    unsigned int x, y, z, runStart;
+    float scale;
+    cellStruct_t *cell;
+    const unsigned char *color, *runColor;
+
+    outputFile = fopen(filename, "w");
+    if(outputFile == NULL)
+    {
+        printf("ERROR, file %s couldn't be opened for writing!\n", filename);
+        return false;
+    }
+
+    // easygl's PostScript output needs an open window for its fonts, so write a plain page of filled cells ourselves
+    // Fit the layers side by side on a letter page with half inch margins, like easygl does
+    scale = std::min(540.f / (gridStruct->gridSizeZ * (gridStruct->gridSizeX + 1) - 1), 720.f / gridStruct->gridSizeY);
+    fprintf(outputFile, "%%!PS-Adobe-1.0\n%%%%Pages: 1\n%%%%BoundingBox: 36 36 %d %d\n%%%%EndComments\n",
+        (int)(36 + scale * (gridStruct->gridSizeZ * (gridStruct->gridSizeX + 1) - 1) + 1), (int)(36 + scale * gridStruct->gridSizeY + 1));
+    fprintf(outputFile, "/cells { newpath moveto 1 index 0 rlineto 0 exch rlineto neg 0 rlineto closepath fill } def\n");
+    fprintf(outputFile, "%%%%Page: 1 1\n36 %.2f translate %.4f %.4f scale\n", 36 + scale * gridStruct->gridSizeY, scale, -scale);
+
+    for(z = 0; z < gridStruct->gridSizeZ; z++)
+    {
+        // Start from the background, like clearing the screen
+        fprintf(outputFile, "%.3f %.3f %.3f setrgbcolor %u %u %u 0 cells\n",
+            imageColors[BACKGROUND_COLOR][0] / 255.f, imageColors[BACKGROUND_COLOR][1] / 255.f, imageColors[BACKGROUND_COLOR][2] / 255.f,
+            gridStruct->gridSizeX, gridStruct->gridSizeY, z * (gridStruct->gridSizeX + 1));
+        for(y = 0; y < gridStruct->gridSizeY; y++)
+        {
+            // Fill runs of same coloured cells along the row together
+            runStart = 0;
+            runColor = NULL;
+            for(x = 0; x <= gridStruct->gridSizeX; x++)
+            {
+                color = NULL;
+                if(x < gridStruct->gridSizeX)
+                {
+                    cell = GetCell(gridStruct, x, y, z);
+                    if(cell->currentCellProp == CELL_OBSTRUCTED)
+                    {
+                        color = imageColors[OBSTRUCTION_COLOR];
+                    }
+                    else if(cell->currentCellProp != CELL_EMPTY)
+                    {
+                        color = imageColors[netColors[GetCellNet(cell) & 7]];
+                    }
+                }
+                if(color == runColor)
+                {
+                    continue;
+                }
+                if(runColor != NULL)
+                {
+                    fprintf(outputFile, "%.3f %.3f %.3f setrgbcolor %u 1 %u %u cells\n",
+                        runColor[0] / 255.f, runColor[1] / 255.f, runColor[2] / 255.f,
+                        x - runStart, z * (gridStruct->gridSizeX + 1) + runStart, y);
+                }
+                runStart = x;
+                runColor = color;
+            }
+        }
+    }
+    fprintf(outputFile, "showpage\n%%%%Trailer\n");
+
+    if(fclose(outputFile) != 0)
+    {
+        printf("ERROR, couldn't write image %s!\n", filename);
+        return false;
+    }
+    printf("Saved a PostScript image of the grid to %s\n", filename);
+    return true;
+}
+
+bool ListInputFiles(const char *path, std::vector<std::string> *filenames)
+{
+    size_t length;
+    std::string directory, line;
+    std::vector<std::string> directoryFilenames;
+    std::ifstream listFile;
+#ifdef WIN32
+    DWORD attributes;
+    WIN32_FIND_DATAA findData;
+    HANDLE findHandle;
+#else
+    struct stat fileStat;
+    DIR *directoryHandle;
+    struct dirent *entry;
+#endif
+
+    length = strlen(path);
+
+    //1. Directories give all of their .infile inputs, in name order
+#ifdef WIN32
+    attributes = GetFileAttributesA(path);
+    if(attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_DIRECTORY))
+    {
+        directory = path;
+        findHandle = FindFirstFileA((directory + "\\*.infile").c_str(), &findData);
+        if(findHandle != INVALID_HANDLE_VALUE)
+        {
+            do
+            {
+                directoryFilenames.push_back(directory + "\\" + findData.cFileName);
+            } while(FindNextFileA(findHandle, &findData));
+            FindClose(findHandle);
+        }
+#else
+    if(stat(path, &fileStat) == 0 && S_ISDIR(fileStat.st_mode))
+    {
+        directory = path;
+        directoryHandle = opendir(path);
+        if(directoryHandle == NULL)
+        {
+            printf("ERROR, directory %s couldn't be opened!\n", path);
+            return false;
+        }
+        while((entry = readdir(directoryHandle)) != NULL)
+        {
+            length = strlen(entry->d_name);
+            if(length > 7 && strcmp(entry->d_name + length - 7, ".infile") == 0)
+            {
+                directoryFilenames.push_back(directory + "/" + entry->d_name);
+            }
+        }
+        closedir(directoryHandle);
+#endif
+        std::sort(directoryFilenames.begin(), directoryFilenames.end());
+        filenames->insert(filenames->end(), directoryFilenames.begin(), directoryFilenames.end());
+        return true;
+    }
+
+    //2. Inputs stand for themselves
+    if((length > 7 && strcmp(path + length - 7, ".infile") == 0) || IsBinaryGridFile(path))
+    {
+        filenames->push_back(path);
+        return true;
+    }
+
+    //3. Anything else is a list of inputs, one per line
+    listFile.open(path);
+    if(!listFile.is_open())
+    {
+        printf("ERROR, file %s couldn't be opened!\n", path);
+        return false;
+    }
+    while(std::getline(listFile, line))
+    {
+        // Skip blank lines and trailing carriage returns
+        if(!line.empty() && line[line.size() - 1] == '\r')
+        {
+            line.erase(line.size() - 1);
+        }
+        if(!line.empty() && !ListInputFiles(line.c_str(), filenames))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RouteBatch(std::vector<std::string> *filenames, gridStruct_t *options, unsigned int layers, unsigned int threads)
+{
+    unsigned int i, routedJobs;
+    FILE *inputFile;
+    std::vector<batchJob_t> jobs;
+    std::vector<std::pair<long, unsigned int>> order;
+    std::vector<batchQueue_t> queues;
+    std::vector<std::thread> workers;
+    std::chrono::steady_clock::time_point startTime;
+    batchJob_t *job;
+    char strBuff[80];
+
+    if(threads == 0)
+    {
+        threads = std::max(std::thread::hardware_concurrency(), 1u);
+    }
+    threads = std::min(threads, (unsigned int)filenames->size());
+
+    //1. One job per input, biggest files first so the long jobs don't end up last
+    jobs.resize(filenames->size());
+    for(i = 0; i < jobs.size(); i++)
+    {
+        jobs[i].filename = (*filenames)[i];
+        jobs[i].parsed = false;
+        jobs[i].seed = options->seed + i;
+        inputFile = fopen(jobs[i].filename.c_str(), "rb");
+        if(inputFile != NULL)
+        {
+            fseek(inputFile, 0, SEEK_END);
+            order.push_back(std::make_pair(ftell(inputFile), i));
+            fclose(inputFile);
+        }
+        else
+        {
+            order.push_back(std::make_pair(0L, i));
+        }
+    }
+    std::sort(order.rbegin(), order.rend());
+
+    //2. Deal the jobs out to every worker's queue, idle workers steal from the others
+    queues = std::vector<batchQueue_t>(threads);
+    for(i = 0; i < order.size(); i++)
+    {
+        queues[i % threads].jobs.push_back(order[i].second);
+    }
+    printf("Routing %u input(s) on %u thread(s) with seed %u\n", (unsigned int)jobs.size(), threads, options->seed);
+    startTime = std::chrono::steady_clock::now();
+    for(i = 0; i < threads; i++)
+    {
+        workers.push_back(std::thread(RouteBatchWorker, &jobs, &queues, i, options, layers));
+    }
+    for(i = 0; i < threads; i++)
+    {
+        workers[i].join();
+    }
+
+    //3. Combined results, in the order the inputs were given
+    printf("\n%-40s %15s %6s %9s %7s %8s\n", "input", "grid", "nets", "routed", "retries", "seconds");
+    routedJobs = 0;
+    for(i = 0; i < jobs.size(); i++)
+    {
+        job = &jobs[i];
+        if(!job->parsed)
+        {
+            printf("%-40s %15s\n", job->filename.c_str(), "parse error");
+            continue;
+        }
+        sprintf(strBuff, "%ux%ux%u", job->gridSizeX, job->gridSizeY, job->gridSizeZ);
+        printf("%-40s %15s %6u %9u %7u %8.3f%s\n", job->filename.c_str(), strBuff,
+            job->nets, job->netsRouted, job->retries, job->wallTime, job->routed ? "" : " FAILED");
+        routedJobs += job->routed ? 1 : 0;
+    }
+    printf("%u of %u input(s) routed in %.3f seconds\n", routedJobs, (unsigned int)jobs.size(),
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+
+    return routedJobs == jobs.size();
+}
+
+void RouteBatchWorker(std::vector<batchJob_t> *jobs, std::vector<batchQueue_t> *queues, unsigned int worker, gridStruct_t *options, unsigned int layers)
+{
+    unsigned int job;
+
+    while(TakeBatchJob(queues, worker, &job))
+    {
+        RouteBatchJob(&(*jobs)[job], options, layers);
+    }
+}
+
+bool TakeBatchJob(std::vector<batchQueue_t> *queues, unsigned int worker, unsigned int *job)
+{
+    unsigned int i;
+    batchQueue_t *queue;
+
+    // Our own queue first, from the front, then steal from the back of everyone else's
+    for(i = 0; i < queues->size(); i++)
+    {
+        queue = &(*queues)[(worker + i) % queues->size()];
+        std::lock_guard<std::mutex> lock(queue->lock);
+        if(queue->jobs.empty())
+        {
+            continue;
+        }
+        if(i == 0)
+        {
+            *job = queue->jobs.front();
+            queue->jobs.pop_front();
+        }
+        else
+        {
+            *job = queue->jobs.back();
+            queue->jobs.pop_back();
+        }
+        return true;
+    }
+    return false;
+}
+
+void RouteBatchJob(batchJob_t *job, gridStruct_t *options, unsigned int layers)
+{
+    parsedInputStruct_t jobInput = parsedInputStruct_t();
+    gridStruct_t jobGrid = gridStruct_t();
+    std::chrono::steady_clock::time_point startTime;
+    const char *filename;
+
+    startTime = std::chrono::steady_clock::now();
+    filename = job->filename.c_str();
+
+    //1. Every job gets its own grid with the options we were given, outputs are named after the input
+    jobGrid.weighted = options->weighted;
+    jobGrid.engine = options->engine;
+    jobGrid.useRouteCache = options->useRouteCache;
+    jobGrid.ripUp = options->ripUp;
+    jobGrid.tiledLayout = options->tiledLayout;
+    jobGrid.timeBudget = options->timeBudget;
+    jobGrid.expansionCap = options->expansionCap;
+    jobGrid.retryPolicy = options->retryPolicy;
+    jobGrid.reservePinAccess = options->reservePinAccess;
+    jobGrid.residentTiles = options->residentTiles;
+    jobGrid.seed = job->seed;
+    jobGrid.rng.seed(jobGrid.seed);
+    if(!options->gridFilename.empty())
+    {
+        jobGrid.gridFilename = job->filename + options->gridFilename;
+    }
+    jobGrid.imageCellPixels = options->imageCellPixels;
+    if(!options->outputFilename.empty())
+    {
+        jobGrid.outputFilename = job->filename + options->outputFilename;
+    }
+    if(!options->telemetryFilename.empty())
+    {
+        jobGrid.telemetryFilename = job->filename + options->telemetryFilename;
+    }
+    if(!options->imageFilename.empty())
+    {
+        jobGrid.imageFilename = job->filename + options->imageFilename;
+    }
+
+    //2. Parse and route it like a single input
+    job->parsed = IsBinaryGridFile(filename) ? LoadBinaryGrid(filename, &jobInput, &jobGrid) : ParseInputFile(filename, &jobInput, false);
+    if(!job->parsed)
+    {
+        return;
+    }
+    if(layers > 0)
+    {
+        jobInput.gridSizeZ = layers;
+    }
+    // A grid that can't be built is reported like one that couldn't be parsed
+    if(!RouterInit(&jobInput, &jobGrid))
+    {
+        job->parsed = false;
+        UnmapGridFile(&jobGrid.gridFile);
+        return;
+    }
+    RestoreSavedRouting(&jobInput, &jobGrid);
+    RouterRun(&jobInput, &jobGrid, STEP_COMPLETE);
+
+    //3. Keep what goes in the results table
+    job->gridSizeX = jobInput.gridSizeX;
+    job->gridSizeY = jobInput.gridSizeY;
+    job->gridSizeZ = jobInput.gridSizeZ;
+    job->nets = (unsigned int)jobInput.nodes.size();
+    job->routed = jobGrid.currentRoutingState == STATE_ROUTE_SUCCESS;
+    job->netsRouted = job->routed ? job->nets : jobGrid.bestNetsRouted;
+    job->retries = jobGrid.currentRetries;
+    job->wallTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+    UnmapGridFile(&jobGrid.gridFile);
+}
+
+bool PopulateCellInfo(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, j, k, numColumns, dir, currentX, currentY;
+    size_t block, blockSize;
+    cellStruct_t tempCell;
+    cellStruct_t *currentCell;
+    cellStruct_t *currentBlock;
+    cellStruct_t *neighbours[DIR_NUM];
+
+    // Cells only have room for so many nets
+    if(parsedInputStruct->nodes.size() >= CELL_MAX_NETS)
+    {
+        printf("ERROR, a grid can't have more than %d nets!\n", CELL_MAX_NETS - 1);
+        return false;
+    }
+    // The whole grid is rebuilt, the window redraws all of it
+    gridStruct->allCellsChanged = true;
+
+    //0. If we've already built this grid, restore its pristine image instead of rebuilding it
+    if(gridStruct->gridSizeX == parsedInputStruct->gridSizeX &&
+        gridStruct->gridSizeY == parsedInputStruct->gridSizeY &&
+        gridStruct->gridSizeZ == parsedInputStruct->gridSizeZ &&
+        (gridStruct->gridFile.data != NULL || (!gridStruct->pristineGrid.empty() && gridStruct->cells.size() == gridStruct->pristineGrid.size())))
+    {
+        // Copying into the equally sized cells (or the same tiles of the grid file) keeps their storage, so pointers to them stay valid
+        if(gridStruct->gridFile.data != NULL)
+        {
+            CopyGridPlane(&gridStruct->gridFile, PLANE_PRISTINE, PLANE_CELLS);
+        }
+        else
+        {
+            gridStruct->cells = gridStruct->pristineGrid;
+        }
+        ResetCellLabels(gridStruct);
+        // Only the pins change between attempts since just the net order (and with some engines the pin order) gets shuffled
+        for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+        {
+            for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+            {
+                currentCell = GetCell(gridStruct, parsedInputStruct->nodes[i][j].posX, parsedInputStruct->nodes[i][j].posY, parsedInputStruct->nodes[i][j].posZ);
+                SetCellNet(gridStruct, currentCell, i);
+                SetCellProp(gridStruct, currentCell, (j == 0) ? CELL_NET_SOURCE : CELL_NET_SINK_UNCONN);
+            }
+        }
+        return true;
+    }
+
+    //1. Initialize for current grid size
+    tempCell.currentCellProp = CELL_EMPTY;
+    SetCellNet(gridStruct, &tempCell, -1);
+    tempCell.cost = WEIGHT_CELL_BASE;
+    tempCell.prevDir = DIR_NUM;
+    tempCell.escapeDir = DIR_NUM;
+    gridStruct->gridSizeX = parsedInputStruct->gridSizeX;
+    gridStruct->gridSizeY = parsedInputStruct->gridSizeY;
+    gridStruct->gridSizeZ = parsedInputStruct->gridSizeZ;
+    gridStruct->gridTilesX = (parsedInputStruct->gridSizeX + GRID_TILE_SIZE - 1) / GRID_TILE_SIZE;
+    gridStruct->gridTilesY = (parsedInputStruct->gridSizeY + GRID_TILE_SIZE - 1) / GRID_TILE_SIZE;
+    gridStruct->cells.clear();
+    gridStruct->cellLabels.clear();
+    UnmapGridFile(&gridStruct->gridFile);
+    // Grid files are stored in tiles, so a tile's neighbours are what gets paged in along with it
+    if(!gridStruct->gridFilename.empty())
+    {
+        gridStruct->tiledLayout = true;
+    }
+    // Every layer gets its own set of columns (or tiles), one layer after the other
+    // Tiles on the right and bottom edges are padded out; the padding cells are never anyone's neighbours so routing can't reach them
+    if(gridStruct->tiledLayout)
+    {
+        numColumns = parsedInputStruct->gridSizeZ * gridStruct->gridTilesX * gridStruct->gridTilesY;
+        gridStruct->cellBlockSize = GRID_TILE_SIZE * GRID_TILE_SIZE;
+    }
+    else
+    {
+        numColumns = parsedInputStruct->gridSizeZ * parsedInputStruct->gridSizeX;
+        gridStruct->cellBlockSize = parsedInputStruct->gridSizeY;
+    }
+    // The grid file is created at its full size, the kernel writes the tiles out to it once it needs the memory back
+    // Its tiles hold a tile's cells or its labels, whichever is larger
+    if(!gridStruct->gridFilename.empty() &&
+        !MapGridFile(gridStruct->gridFilename.c_str(), &gridStruct->gridFile, numColumns, gridStruct->cellBlockSize * std::max(sizeof(cellStruct_t), sizeof(int))))
+    {
+        printf("ERROR, couldn't map the grid file %s, keeping the cells in memory!\n", gridStruct->gridFilename.c_str());
+        gridStruct->gridFilename.clear();
+    }
+    if(gridStruct->gridFile.data != NULL)
+    {
+        gridStruct->gridFile.maxResident = (gridStruct->residentTiles > 0) ? gridStruct->residentTiles : GRID_FILE_RESIDENT_TILES;
+        for(i = 0; i < numColumns; i++)
+        {
+            currentBlock = GetTileCells(&gridStruct->gridFile, PLANE_CELLS, i);
+            for(j = 0; j < gridStruct->cellBlockSize; j++)
+            {
+                currentBlock[j] = tempCell;
+            }
+        }
+    }
+    else
+    {
+        gridStruct->cells.assign((size_t)numColumns * gridStruct->cellBlockSize, tempCell);
+    }
+    ResetCellLabels(gridStruct);
+
+    // Layers alternate preferred directions, starting horizontally; a single layer has no preference
+    gridStruct->layerDirections.clear();
+    for(k = 0; k < parsedInputStruct->gridSizeZ; k++)
+    {
+        if(parsedInputStruct->gridSizeZ == 1)
+        {
+            gridStruct->layerDirections.push_back(PREF_DIR_NONE);
+        }
+        else if(k % 2 == 0)
+        {
+            gridStruct->layerDirections.push_back(PREF_DIR_HORIZONTAL);
+        }
+        else
+        {
+            gridStruct->layerDirections.push_back(PREF_DIR_VERTICAL);
+        }
+    }
+
+    //2. Populate obstructions
+    for(i = 0; i < parsedInputStruct->obstructions.size(); i++)
+    {
+        currentX = parsedInputStruct->obstructions[i].posX;
+        currentY = parsedInputStruct->obstructions[i].posY;
+
+        currentCell = GetCell(gridStruct, currentX, currentY, parsedInputStruct->obstructions[i].posZ);
+
+        SetCellProp(gridStruct, currentCell, CELL_OBSTRUCTED);
+    }
+
+    //3. Populate net sources and sinks
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+        {
+            currentX = parsedInputStruct->nodes[i][j].posX;
+            currentY = parsedInputStruct->nodes[i][j].posY;
+
+            currentCell = GetCell(gridStruct, currentX, currentY, parsedInputStruct->nodes[i][j].posZ);
+
+            SetCellNet(gridStruct, currentCell, i);
+
+            // If we're the first entry we are a source, otherwise we are a sink
+            if(j == 0)
+            {
+                SetCellProp(gridStruct, currentCell, CELL_NET_SOURCE);
+            }
+            else
+            {
+                SetCellProp(gridStruct, currentCell, CELL_NET_SINK_UNCONN);
+            }
+        }
+    }
+
+    //4. Populate weighted routing costs
+    // Cells hugging obstructions or other pins on the same layer are more expensive so weighted routes leave room around them
+    for(block = 0; block < GetNumCellBlocks(gridStruct); block++)
+    {
+        currentBlock = GetCellBlock(gridStruct, block, &blockSize);
+        for(j = 0; j < blockSize; j++)
+        {
+            currentCell = &currentBlock[j];
+            // The padding cells of the tiles on the edges aren't in the grid
+            if(gridStruct->tiledLayout && (block % gridStruct->gridTilesX * GRID_TILE_SIZE + j % GRID_TILE_SIZE >= gridStruct->gridSizeX ||
+                block / gridStruct->gridTilesX % gridStruct->gridTilesY * GRID_TILE_SIZE + j / GRID_TILE_SIZE >= gridStruct->gridSizeY))
+            {
+                continue;
+            }
+            GetNeighbours(gridStruct, currentCell, neighbours);
+
+            for(dir = DIR_NORTH; dir < DIR_UP; dir++)
+            {
+                if(neighbours[dir] == NULL)
+                {
+                    continue;
+                }
+                switch(neighbours[dir]->currentCellProp)
+                {
+                    case CELL_OBSTRUCTED:
+                        currentCell->cost += WEIGHT_OBSTRUCTION_PROXIMITY;
+                        break;
+                    case CELL_NET_SOURCE:
+                    case CELL_NET_SINK_UNCONN:
+                        currentCell->cost += WEIGHT_PIN_PROXIMITY;
+                        break;
+                    default:
+                        break;
+                }
+            }
+        }
+        ReleaseCellBlock(gridStruct, block);
+    }
+
+    //5. Reserve the pins' escapes, they're only tied to the pins so they stay valid however the nets are shuffled
+    if(gridStruct->reservePinAccess)
+    {
+        ReservePinAccess(parsedInputStruct, gridStruct);
+    }
+
+    //6. Keep a pristine image of the grid to restore on later attempts (copying the grid file's tiles drops them all from memory)
+    if(gridStruct->gridFile.data != NULL)
+    {
+        CopyGridPlane(&gridStruct->gridFile, PLANE_CELLS, PLANE_PRISTINE);
+    }
+    else
+    {
+        gridStruct->pristineGrid = gridStruct->cells;
+    }
+
+    return true;
+}
+
+void DrawCell(cellSnapshot_t *cell, unsigned int x, unsigned int y)
+{
+    float currentXOrigin, currentYOrigin;
+    const char *label;
+    char strBuff[80];
+
+    // Make things clean by setting our origin here
+    currentXOrigin = (float)(gridMarginX + x * cellSizeX);
+    currentYOrigin = (float)(gridMarginY + y * cellSizeY);
+
+    set_draw_mode(DRAW_NORMAL);
+    label = NULL;
+
+    // Depending on the cell type, draw the cell
+    switch(cell->currentCellProp)
+    {
+        case CELL_OBSTRUCTED:
+            setcolor(OBSTRUCTION_COLOR);
+            fillrect(
+                currentXOrigin, currentYOrigin,
+                currentXOrigin + cellSizeX, currentYOrigin + cellSizeY
+            );
+            break;
+        case CELL_NET_WIRE_UNCONN:
+            setcolor(netColors[cell->currentNet & 7]);
+            fillrect(
+                currentXOrigin, currentYOrigin,
+                currentXOrigin + cellSizeX, currentYOrigin + cellSizeY
+            );
+            label = "X";
+            break;
+        case CELL_NET_WIRE_CONN:
+            setcolor(netColors[cell->currentNet & 7]);
+            fillrect(
+                currentXOrigin, currentYOrigin,
+                currentXOrigin + cellSizeX, currentYOrigin + cellSizeY
+            );
+            break;
+        case CELL_NET_SOURCE:
+            setcolor(netColors[cell->currentNet & 7]);
+            fillrect(
+                currentXOrigin, currentYOrigin,
+                currentXOrigin + cellSizeX, currentYOrigin + cellSizeY
+            );
+            label = "SRC";
+            break;
+        case CELL_NET_SINK_UNCONN:
+            setcolor(netColors[cell->currentNet & 7]);
+            fillrect(
+                currentXOrigin, currentYOrigin,
+                currentXOrigin + cellSizeX, currentYOrigin + cellSizeY
+            );
+            label = "SNK_X";
+            break;
+        case CELL_NET_SINK_CONN:
+            setcolor(netColors[cell->currentNet & 7]);
+            fillrect(
+                currentXOrigin, currentYOrigin,
+                currentXOrigin + cellSizeX, currentYOrigin + cellSizeY
+            );
+            label = "SNK";
+            break;
+        case CELL_EMPTY:
+            if(drawCellOutlines)
+            {
+                setcolor(GRID_COLOR);
+                drawrect(
+                    currentXOrigin, currentYOrigin,
+                    currentXOrigin + cellSizeX, currentYOrigin + cellSizeY
+                );
+            }
+            break;
+        default:
+            // Should never be in here
+            break;
+    }
+
+    // Text would be unreadable on small cells, and it's the slowest thing to draw
+    if(!drawCellText)
+    {
+        return;
+    }
+
+    if(label != NULL)
+    {
+        setcolor(WHITE);
+        setfontsize(10);
+        drawtext(currentXOrigin + 0.5f*cellSizeX, currentYOrigin + 0.5f*cellSizeY, label, 800.);
+    }
+
+    // During expansion, show the number
+    if(cell->currentNumber > 0)
+    {
+        sprintf(strBuff, "%d", cell->currentNumber);
+        setcolor(WHITE);
+        setfontsize(10);
+        drawtext(currentXOrigin + 0.5f*cellSizeX, currentYOrigin + 0.5f*cellSizeY, strBuff, 800.);
+    }
+}
+
+void DrawScreen(void)
+{
+    unsigned int i, j;
+    t_report report = t_report();
+    float cellPixels;
+    cellSnapshot_t cellSnapshot;
+
+    set_draw_mode(DRAW_NORMAL);
+    clearscreen();  /* Should precede drawing for all drawscreens */
+
+    // Pick the level of detail from how big cells are on screen at the current zoom
+    report_structure(&report);
+    cellPixels = cellSizeX * report.xmult;
+    drawCellText = cellPixels >= LOD_MIN_TEXT_PIXELS;
+    drawCellOutlines = cellPixels >= LOD_MIN_OUTLINE_PIXELS;
+
+    // Draw grid on screen
+    setlinestyle(SOLID);
+    setlinewidth(0);
+
+    // Everything gets drawn as it is now, so forget what changed before (the routing thread hands its changes over with its snapshots)
+    if(!drawnSnapshot)
+    {
+        grid->changedCells.clear();
+        grid->allCellsChanged = false;
+    }
+    screenChangedCells.clear();
+    screenAllCellsChanged = false;
+    screenLayer = displayLayer;
+    for(i = 0; i < input->gridSizeX; i++)
+    {
+        for(j = 0; j < input->gridSizeY; j++)
+        {
+            // Draw cell on the layer being displayed
+            GetScreenCell(i, j, &cellSnapshot);
+            DrawCell(&cellSnapshot, i, j);
+        }
+    }
+}
+
+void UpdateScreen(void)
+{
+    size_t i;
+    float currentXOrigin, currentYOrigin;
+    cellSnapshot_t cellSnapshot;
+    posStruct_t *pos;
+
+    // Take the cells the grid changed since the last frame, while routing in the background they come with the snapshots instead
+    if(!drawnSnapshot)
+    {
+        TakeChangedCells(grid, &screenChangedCells, &screenAllCellsChanged);
+    }
+
+    // Nothing to go by, draw everything
+    if(screenAllCellsChanged || screenLayer != displayLayer)
+    {
+        DrawScreen();
+        return;
+    }
+
+    set_draw_mode(DRAW_NORMAL);
+    setlinestyle(SOLID);
+    setlinewidth(0);
+
+    // Only redraw the cells that changed on the layer on screen
+    for(i = 0; i < screenChangedCells.size(); i++)
+    {
+        pos = &screenChangedCells[i];
+        if(pos->posZ != displayLayer)
+        {
+            continue;
+        }
+        GetScreenCell(pos->posX, pos->posY, &cellSnapshot);
+
+        // Clear what was drawn there before
+        currentXOrigin = (float)(gridMarginX + pos->posX * cellSizeX);
+        currentYOrigin = (float)(gridMarginY + pos->posY * cellSizeY);
+        setcolor(BACKGROUND_COLOR);
+        fillrect(
+            currentXOrigin, currentYOrigin,
+            currentXOrigin + cellSizeX, currentYOrigin + cellSizeY
+        );
+        DrawCell(&cellSnapshot, pos->posX, pos->posY);
+    }
+    screenChangedCells.clear();
+}
+
+void TakeChangedCells(gridStruct_t *gridStruct, std::vector<posStruct_t> *changedCells, bool *allCellsChanged)
+{
+    // Add the grid's changes to the ones not drawn yet, redrawing more cells than the grid has is no cheaper than redrawing the grid
+    if(gridStruct->allCellsChanged || changedCells->size() + gridStruct->changedCells.size() >= (size_t)gridStruct->gridSizeX * gridStruct->gridSizeY * gridStruct->gridSizeZ)
+    {
+        *allCellsChanged = true;
+    }
+    if(*allCellsChanged)
+    {
+        changedCells->clear();
+    }
+    else
+    {
+        changedCells->insert(changedCells->end(), gridStruct->changedCells.begin(), gridStruct->changedCells.end());
+    }
+    gridStruct->changedCells.clear();
+    gridStruct->allCellsChanged = false;
+}
+
+void GetScreenCell(unsigned int x, unsigned int y, cellSnapshot_t *cellSnapshot)
+{
+    cellStruct_t *cell;
+
+    // While the routing thread runs, the grid is only drawn from its snapshots
+    if(drawnSnapshot)
+    {
+        *cellSnapshot = drawnSnapshot->cells[((size_t)displayLayer * drawnSnapshot->gridSizeY + y) * drawnSnapshot->gridSizeX + x];
+    }
+    else
+    {
+        cell = GetCell(grid, x, y, displayLayer);
+        cellSnapshot->currentCellProp = (cellProp_e)cell->currentCellProp;
+        cellSnapshot->currentNet = GetCellNet(cell);
+        cellSnapshot->currentNumber = GetCellLabel(grid, cell);
+    }
+}
+
+bool RouterInit(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i;
+    std::vector<std::vector<posStruct_t>> newNodes;
+    // Shuffle the net order
+    std::shuffle(parsedInputStruct->nodes.begin(), parsedInputStruct->nodes.end(), gridStruct->rng);
+    // The time budget starts with the first attempt, retries put the nets that failed before first
+    if(gridStruct->currentRetries == 0)
+    {
+        gridStruct->budgetStart = std::chrono::steady_clock::now();
+        gridStruct->budgetExpired = false;
+        gridStruct->netFailures.clear();
+        // Find the nets no order can route before the first attempt
+        if(gridStruct->reservePinAccess)
+        {
+            FindWalledInNets(parsedInputStruct, gridStruct);
+        }
+    }
+    else if(gridStruct->retryPolicy != RETRY_SHUFFLE)
+    {
+        PromoteFailedNets(parsedInputStruct, gridStruct);
+    }
+    // The nets with a walled in pin go last, so the attempt only fails on them once every other net is routed
+    if(!gridStruct->walledInNets.empty())
+    {
+        newNodes.clear();
+        for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+        {
+            if(!IsNetWalledIn(parsedInputStruct, gridStruct, i))
+            {
+                newNodes.push_back(parsedInputStruct->nodes[i]);
+            }
+        }
+        for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+        {
+            if(IsNetWalledIn(parsedInputStruct, gridStruct, i))
+            {
+                newNodes.push_back(parsedInputStruct->nodes[i]);
+            }
+        }
+        parsedInputStruct->nodes = newNodes;
+    }
+    // Let the engine set up the attempt (the pins need shuffling before the grid is populated)
+    if(gridStruct->engine->init != NULL)
+    {
+        gridStruct->engine->init(parsedInputStruct, gridStruct);
+    }
+    // Populate cell information, there's nothing to route if the grid can't be built
+    if(!PopulateCellInfo(parsedInputStruct, gridStruct))
+    {
+        return false;
+    }
+    // Initialize algorithm state and starting net
+    gridStruct->currentRoutingState = STATE_IDLE;
+    gridStruct->netEngine = gridStruct->engine;
+    gridStruct->fallbackNets = 0;
+    gridStruct->currentNet = 0;
+    gridStruct->currentExpansion = 0;
+    gridStruct->currentRipUps = 0;
+    // Clear out the expansion list
+    gridStruct->expansionList.clear();
+    // Clear our our last route
+    gridStruct->lastRoute.clear();
+    // Clear the last cell pointer
+    gridStruct->lastCell = NULL;
+    // Clear out the line probe's nodes and edges
+    gridStruct->currentNodes.clear();
+    gridStruct->currentEdges.clear();
+    gridStruct->currentNodePointer = NULL;
+    gridStruct->nextNodePointer = NULL;
+    gridStruct->nextNodeDir[DIR_IDX_NS_Y] = DIR_NUM;
+    gridStruct->nextNodeDir[DIR_IDX_EW_X] = DIR_NUM;
+    gridStruct->nextNodeDir[DIR_IDX_UD_Z] = DIR_NUM;
+    gridStruct->directionIndex = DIR_IDX_NUM;
+    // Reset our net route counts
+    // For each net, we will only have to route nodes - 1 since we don't count the source
+    gridStruct->netRoutedNodes.clear();
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        gridStruct->netRoutedNodes.push_back(parsedInputStruct->nodes[i].size() - 1);
+    }
+
+    return true;
+}
+
+void RouterExec(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, stepType_e stepType)
+{
+    char strBuff[80];
+
+    // Run the router, then show where it got to (the caller redraws the grid)
+    RouterRun(parsedInputStruct, gridStruct, stepType);
+    GetStatusMessage(gridStruct, strBuff);
+    update_message(strBuff);
+}
+
+void RouterRun(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, stepType_e stepType)
+{
+    unsigned int currentNet;
+
+    // Keep track of our current net
+    currentNet = gridStruct->currentNet;
+
+    // Step until we're done routing, or we've taken as big of a step as we were asked to
+    while(RouterStep(parsedInputStruct, gridStruct))
+    {
+        if(stepType == STEP_SINGLE)
+        {
+            break;
+        }
+        // Finished this net
+        if(stepType == STEP_NET && currentNet != gridStruct->currentNet)
+        {
+            break;
+        }
+    }
+}
+
+void TakeGridSnapshot(gridStruct_t *gridStruct, gridSnapshot_t *snapshot)
+{
+    unsigned int x, y, z;
+    cellStruct_t *cell;
+    cellSnapshot_t *cellSnapshot;
+    char strBuff[80];
+
+    // Copy only what's drawn of every cell
+    snapshot->gridSizeX = gridStruct->gridSizeX;
+    snapshot->gridSizeY = gridStruct->gridSizeY;
+    snapshot->gridSizeZ = gridStruct->gridSizeZ;
+    snapshot->cells.resize((size_t)gridStruct->gridSizeX * gridStruct->gridSizeY * gridStruct->gridSizeZ);
+    cellSnapshot = snapshot->cells.data();
+    for(z = 0; z < gridStruct->gridSizeZ; z++)
+    {
+        for(y = 0; y < gridStruct->gridSizeY; y++)
+        {
+            for(x = 0; x < gridStruct->gridSizeX; x++)
+            {
+                cell = GetCell(gridStruct, x, y, z);
+                cellSnapshot->currentCellProp = (cellProp_e)cell->currentCellProp;
+                cellSnapshot->currentNet = GetCellNet(cell);
+                cellSnapshot->currentNumber = GetCellLabel(gridStruct, cell);
+                cellSnapshot++;
+            }
+        }
+    }
+    GetStatusMessage(gridStruct, strBuff);
+    snapshot->message = strBuff;
+}
+
+void PublishGridSnapshot(gridStruct_t *gridStruct)
+{
+    gridSnapshot_t *snapshot;
+
+    // Take the snapshot outside the lock, the window only ever swaps pointers under it
+    snapshot = new gridSnapshot_t();
+    TakeGridSnapshot(gridStruct, snapshot);
+
+    // The cells changed since the last snapshot go along with it
+    std::lock_guard<std::mutex> lock(snapshotMutex);
+    latestSnapshot.reset(snapshot);
+    TakeChangedCells(gridStruct, &pendingChangedCells, &pendingAllCellsChanged);
+}
+
+void StartRoutingThread(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, stepType_e stepType)
+{
+    // Draw from a snapshot right away, the grid belongs to the routing thread from now on
+    PublishGridSnapshot(gridStruct);
+    drawnSnapshot = latestSnapshot;
+
+    routingDone = false;
+    routingCancelled = false;
+    routingThread = std::thread(RoutingThread, parsedInputStruct, gridStruct, stepType);
+
+    // Redraw the latest snapshot at a fixed rate until the routing thread is done
+    set_timer_callback(ActOnRoutingTimer, ROUTING_FRAME_MS);
+    update_message("Routing... press C to cancel");
+}
+
+void RoutingThread(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, stepType_e stepType)
+{
+    unsigned int currentNet;
+    std::chrono::steady_clock::time_point lastSnapshot;
+
+    // Keep track of our current net
+    currentNet = gridStruct->currentNet;
+    lastSnapshot = std::chrono::steady_clock::now();
+
+    // Step like RouterRun does, stopping between steps if we're cancelled
+    while(!routingCancelled && RouterStep(parsedInputStruct, gridStruct))
+    {
+        // Finished this net
+        if(stepType == STEP_NET && currentNet != gridStruct->currentNet)
+        {
+            break;
+        }
+        // Only copy the grid as often as the window draws it
+        if(std::chrono::steady_clock::now() - lastSnapshot >= std::chrono::milliseconds(ROUTING_FRAME_MS))
+        {
+            PublishGridSnapshot(gridStruct);
+            lastSnapshot = std::chrono::steady_clock::now();
+        }
+    }
+
+    routingDone = true;
+}
+
+void StopRoutingThread(void)
+{
+    char strBuff[80];
+
+    if(!routingThread.joinable())
+    {
+        return;
+    }
+
+    // Wait for the routing thread to finish its current step, the grid is ours again after this
+    routingCancelled = true;
+    routingThread.join();
+    set_timer_callback(NULL, 0);
+    latestSnapshot.reset();
+    drawnSnapshot.reset();
+    // The cells changed in snapshots we never drew still need redrawing, from the grid itself now
+    screenChangedCells.insert(screenChangedCells.end(), pendingChangedCells.begin(), pendingChangedCells.end());
+    screenAllCellsChanged = screenAllCellsChanged || pendingAllCellsChanged;
+    pendingChangedCells.clear();
+    pendingAllCellsChanged = false;
+
+    GetStatusMessage(grid, strBuff);
+    update_message(strBuff);
+}
+
+void ActOnRoutingTimer(void)
+{
+    std::shared_ptr<const gridSnapshot_t> snapshot;
+
+    // Once the routing thread is done, go back to drawing the grid itself
+    if(routingDone)
+    {
+        StopRoutingThread();
+        UpdateScreen();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(snapshotMutex);
+        snapshot = latestSnapshot;
+        // Take the cells changed in every snapshot up to this one, even the ones we skipped
+        screenChangedCells.insert(screenChangedCells.end(), pendingChangedCells.begin(), pendingChangedCells.end());
+        screenAllCellsChanged = screenAllCellsChanged || pendingAllCellsChanged;
+        pendingChangedCells.clear();
+        pendingAllCellsChanged = false;
+    }
+
+    // Only redraw if the routing thread published something new
+    if(snapshot != drawnSnapshot)
+    {
+        drawnSnapshot = snapshot;
+        UpdateScreen();
+        update_message(drawnSnapshot->message.c_str());
+    }
+}
+
+void GetStatusMessage(gridStruct_t *gridStruct, char *strBuff)
+{
+    // Describe the step the router is about to take
+    switch(gridStruct->currentRoutingState)
+    {
+        case STATE_IDLE:
+            sprintf(strBuff, "Ready to route! Next net: %d", gridStruct->currentNet);
+            break;
+        case STATE_SEEK:
+            sprintf(strBuff, "Currently seeking net: %d node: %d", gridStruct->currentNet, gridStruct->netRoutedNodes[gridStruct->currentNet]);
+            break;
+        case STATE_EXPANSION:
+            sprintf(strBuff, "Currently expanding net: %d layer: %d", gridStruct->currentNet, gridStruct->currentExpansion);
+            break;
+        case STATE_WALKBACK:
+            sprintf(strBuff, "Currently walking back net: %d layer: %d", gridStruct->currentNet, gridStruct->currentExpansion);
+            break;
+        case STATE_RIPUP:
+            sprintf(strBuff, "Ripping up nets blocking net %d", gridStruct->currentNet);
+            break;
+        case STATE_ROUTE_FAILURE:
+            if(gridStruct->currentRetries < gridStruct->engine->maxRetries)
+            {
+                sprintf(strBuff, "Route failed on net %d, retrying (%d of %d)", gridStruct->currentNet, gridStruct->currentRetries + 1, gridStruct->engine->maxRetries);
+            }
+            else
+            {
+                sprintf(strBuff, "Route failed on net %d!", gridStruct->currentNet);
+            }
+            break;
+        case STATE_ROUTE_SUCCESS:
+            sprintf(strBuff, "Route SUCCESS after trying %d time(s)", gridStruct->currentRetries + 1);
+            break;
+        default:
+            strBuff[0] = '\0';
+            break;
+    }
+}
+
+bool RouterStep(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    // Stop wherever we are once the time budget runs out, the best grid so far is our answer
+    if(gridStruct->currentRoutingState != STATE_ROUTE_SUCCESS && gridStruct->currentRoutingState != STATE_ROUTE_FAILURE && TimeBudgetExpired(gridStruct))
+    {
+        ResetCellExpansion(gridStruct);
+        gridStruct->expansionList.clear();
+        gridStruct->currentRoutingState = STATE_ROUTE_FAILURE;
+    }
+
+    // Execute routing step based on current state
+    switch(gridStruct->currentRoutingState)
+    {
+        case STATE_IDLE:
+            // Ready to route! Hand the next net to the engine...
+            BeginNet(parsedInputStruct, gridStruct);
+            break;
+        case STATE_SEEK:
+        case STATE_EXPANSION:
+        case STATE_WALKBACK:
+            // The engine routing the net takes it from here until it finishes or fails the net
+            gridStruct->netEngine->step(parsedInputStruct, gridStruct);
+            // Unless it's still searching past the net's expansion cap
+            if(gridStruct->expansionCap > 0 && gridStruct->currentTelemetry.cellsExpanded > gridStruct->expansionCap &&
+                (gridStruct->currentRoutingState == STATE_SEEK || gridStruct->currentRoutingState == STATE_EXPANSION))
+            {
+                if(gridStruct->verbose)
+                {
+                    printf("Net %d expanded past its cap of %llu cells\n", gridStruct->currentNet, gridStruct->expansionCap);
+                }
+                ResetCellExpansion(gridStruct);
+                gridStruct->expansionList.clear();
+                gridStruct->currentExpansion = 0;
+                FailNet(parsedInputStruct, gridStruct);
+            }
+            break;
+        case STATE_RIPUP:
+            // Rip up the nets in the failed net's way and carry on instead of restarting
+            EndNetTelemetry(gridStruct, false);
+            if(gridStruct->currentRipUps < MAXIMUM_RIPUPS_PER_ATTEMPT && RipUpBlockingNets(parsedInputStruct, gridStruct))
+            {
+                gridStruct->currentRipUps++;
+                gridStruct->currentRoutingState = STATE_IDLE;
+            }
+            else
+            {
+                printf("Nothing left to rip up for net %d\n", gridStruct->currentNet);
+                gridStruct->currentRoutingState = STATE_ROUTE_FAILURE;
+            }
+            break;
+        case STATE_ROUTE_FAILURE:
+            // We failed the last route
+            EndNetTelemetry(gridStruct, false);
+            // Remember the net that failed for the retry policy (unless we only stopped because we ran out of time)
+            if(!gridStruct->budgetExpired)
+            {
+                RecordFailedNet(parsedInputStruct, gridStruct);
+            }
+            // If we have more retries and time, rip up routed nets and try again (no attempt gets past a walled in pin)
+            if(gridStruct->currentRetries < gridStruct->engine->maxRetries && !TimeBudgetExpired(gridStruct) &&
+                !IsNetWalledIn(parsedInputStruct, gridStruct, gridStruct->currentNet))
+            {
+                gridStruct->currentRetries++;
+                RouterInit(parsedInputStruct, gridStruct);
+                // Attempts start from the saved routing, if we have one, until half of our retries are gone and then we route from scratch
+                if(gridStruct->currentRetries < gridStruct->engine->maxRetries / 2)
+                {
+                    RestoreSavedRouting(parsedInputStruct, gridStruct);
+                }
+                break;
+            }
+            // Out of retries, don't keep routing :(
+            // Only show the best grid if we have one, replacing the cells with an empty grid would invalidate the pristine image
+            RestoreBestGrid(gridStruct);
+            if(gridStruct->budgetExpired)
+            {
+                printf("Time budget of %.3f s ran out after %d attempt(s), %d of %d nets routed at best\n", gridStruct->timeBudget, gridStruct->currentRetries + 1,
+                    gridStruct->bestNetsRouted, (int)parsedInputStruct->nodes.size());
+            }
+            if(IsNetWalledIn(parsedInputStruct, gridStruct, gridStruct->currentNet))
+            {
+                printf("Every net but the ones with a walled in pin was routed, no attempt can route those\n");
+            }
+            printf("Route failed - showing best grid!\n");
+            // Save the best grid and the telemetry
+            if(!gridStruct->outputFilename.empty())
+            {
+                SaveBinaryGrid(gridStruct->outputFilename.c_str(), parsedInputStruct, gridStruct);
+            }
+            if(!gridStruct->telemetryFilename.empty())
+            {
+                WriteTelemetry(gridStruct->telemetryFilename.c_str(), gridStruct);
+            }
+            if(!gridStruct->imageFilename.empty())
+            {
+                WriteGridImage(gridStruct->imageFilename.c_str(), gridStruct, std::max(gridStruct->imageCellPixels, 1u));
+            }
+            return false;
+        case STATE_ROUTE_SUCCESS:
+            // We've successfully routed! Yay!
+            printf("Route SUCCESS!\n");
+            if(gridStruct->useRouteCache)
+            {
+                printf("%d route(s) replayed from the cache\n", gridStruct->routeCacheHits);
+            }
+            if(gridStruct->engine->fallback != NULL)
+            {
+                printf("%d net(s) routed by %s after %s gave up on them\n", gridStruct->fallbackNets, gridStruct->engine->fallback->name, gridStruct->engine->name);
+            }
+            if(!gridStruct->outputFilename.empty())
+            {
+                SaveBinaryGrid(gridStruct->outputFilename.c_str(), parsedInputStruct, gridStruct);
+            }
+            if(!gridStruct->telemetryFilename.empty())
+            {
+                WriteTelemetry(gridStruct->telemetryFilename.c_str(), gridStruct);
+            }
+            if(!gridStruct->imageFilename.empty())
+            {
+                WriteGridImage(gridStruct->imageFilename.c_str(), gridStruct, std::max(gridStruct->imageCellPixels, 1u));
+            }
+            return false;
+        default:
+            break;
+    }
+
+    return true;
+}
+
+void BeginNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i;
+
+    // Nothing left to route (there's nothing to route in a grid without nets)
+    if(gridStruct->currentNet >= parsedInputStruct->nodes.size())
+    {
+        gridStruct->currentRoutingState = STATE_ROUTE_SUCCESS;
+        return;
+    }
+    // Start recording the new net
+    BeginNetTelemetry(parsedInputStruct, gridStruct);
+    // A net with a walled in pin fails without a search, every net after it is walled in too
+    gridStruct->reservationsLifted = false;
+    if(IsNetWalledIn(parsedInputStruct, gridStruct, gridStruct->currentNet))
+    {
+        gridStruct->currentRoutingState = STATE_ROUTE_FAILURE;
+        return;
+    }
+    // Bring the tiles around the net's pins into the grid file's working set, and drop the ones no net has used in a while
+    if(gridStruct->gridFile.data != NULL)
+    {
+        for(i = 0; i < parsedInputStruct->nodes[gridStruct->currentNet].size(); i++)
+        {
+            TouchTile(&gridStruct->gridFile, GetCell(gridStruct, parsedInputStruct->nodes[gridStruct->currentNet][i].posX,
+                parsedInputStruct->nodes[gridStruct->currentNet][i].posY, parsedInputStruct->nodes[gridStruct->currentNet][i].posZ));
+        }
+        TrimWorkingSet(&gridStruct->gridFile);
+    }
+    // Remember what the net's surroundings look like, and replay its cached route if they haven't changed
+    if(gridStruct->useRouteCache)
+    {
+        gridStruct->currentWindowHash = GetWindowHash(parsedInputStruct, gridStruct);
+        if(ReplayCachedRoute(parsedInputStruct, gridStruct))
+        {
+            FinishNet(parsedInputStruct, gridStruct);
+            return;
+        }
+    }
+    // Every net starts out with the grid's engine
+    gridStruct->netEngine = gridStruct->engine;
+    gridStruct->netEngine->beginNet(parsedInputStruct, gridStruct);
+}
+
+void ResetCellExpansion(gridStruct_t *gridStruct)
+{
+    unsigned int i, j;
+    bool mapped;
+
+    // The tiles an expansion went through are the grid file's working set
+    mapped = (gridStruct->gridFile.data != NULL);
+    for(i = 0; i < gridStruct->expansionList.size(); i++)
+    {
+        for(j = 0; j < gridStruct->expansionList[i].size(); j++)
+        {
+            SetCellLabel(gridStruct, gridStruct->expansionList[i][j], -1);
+            gridStruct->expansionList[i][j]->prevDir = DIR_NUM;
+            if(mapped)
+            {
+                TouchTile(&gridStruct->gridFile, gridStruct->expansionList[i][j]);
+            }
+        }
+    }
+}
+
+void FinishNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i;
+
+    // Done recording this net
+    EndNetTelemetry(gridStruct, true);
+    // Remember this net's route for later attempts
+    if(gridStruct->useRouteCache)
+    {
+        StoreCachedRoute(parsedInputStruct, gridStruct);
+    }
+    // The net's route stays in the grid file's working set
+    if(gridStruct->gridFile.data != NULL)
+    {
+        for(i = 0; i < gridStruct->lastRoute.size(); i++)
+        {
+            TouchTile(&gridStruct->gridFile, gridStruct->lastRoute[i]);
+        }
+    }
+    // Clear the last route
+    gridStruct->lastRoute.clear();
+    gridStruct->currentNodes.clear();
+    gridStruct->currentEdges.clear();
+    // Go to the next net
+    gridStruct->currentNet++;
+    // Save this grid if it's our best yet
+    if(gridStruct->currentNet > gridStruct->bestNetsRouted)
+    {
+        gridStruct->bestNetsRouted = gridStruct->currentNet;
+        SaveBestGrid(gridStruct);
+    }
+    // Check if this was our last net
+    if(gridStruct->currentNet == parsedInputStruct->nodes.size())
+    {
+        // If so, we're done!
+        gridStruct->currentRoutingState = STATE_ROUTE_SUCCESS;
+    }
+    else
+    {
+        // More nets to route...
+        gridStruct->currentRoutingState = STATE_IDLE;
+    }
+}
+
+void FailNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    // Give the net to the fallback engine, if the engine has one, before giving up on it
+    if(gridStruct->netEngine->fallback != NULL)
+    {
+        if(gridStruct->verbose)
+        {
+            printf("%s gave up on net %d, handing it to %s\n", gridStruct->netEngine->name, gridStruct->currentNet, gridStruct->netEngine->fallback->name);
+        }
+        ResetNet(parsedInputStruct, gridStruct);
+        gridStruct->netEngine = gridStruct->netEngine->fallback;
+        gridStruct->fallbackNets++;
+        gridStruct->netEngine->beginNet(parsedInputStruct, gridStruct);
+        return;
+    }
+    // The other nets' escapes are only held back as long as that doesn't cost us the net, give it another go with them
+    if(gridStruct->reservePinAccess && !gridStruct->reservationsLifted)
+    {
+        if(gridStruct->verbose)
+        {
+            printf("Net %d failed around the other nets' pin escapes, routing it through them\n", gridStruct->currentNet);
+        }
+        ResetNet(parsedInputStruct, gridStruct);
+        gridStruct->reservationsLifted = true;
+        gridStruct->netEngine = gridStruct->engine;
+        gridStruct->netEngine->beginNet(parsedInputStruct, gridStruct);
+        return;
+    }
+    // Otherwise rip up what's in the way, or start over
+    gridStruct->currentRoutingState = gridStruct->ripUp ? STATE_RIPUP : STATE_ROUTE_FAILURE;
+}
+
+void ResetNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i;
+    cellStruct_t *currentCell;
+
+    //1. Take back the wires the net has laid down so far
+    for(i = 0; i < gridStruct->lastRoute.size(); i++)
+    {
+        if(gridStruct->lastRoute[i]->currentCellProp == CELL_NET_WIRE_CONN || gridStruct->lastRoute[i]->currentCellProp == CELL_NET_WIRE_UNCONN)
+        {
+            SetCellProp(gridStruct, gridStruct->lastRoute[i], CELL_EMPTY);
+            SetCellNet(gridStruct, gridStruct->lastRoute[i], -1);
+        }
+    }
+
+    //2. Disconnect its sinks again
+    for(i = 1; i < parsedInputStruct->nodes[gridStruct->currentNet].size(); i++)
+    {
+        currentCell = GetCell(gridStruct, parsedInputStruct->nodes[gridStruct->currentNet][i].posX,
+            parsedInputStruct->nodes[gridStruct->currentNet][i].posY, parsedInputStruct->nodes[gridStruct->currentNet][i].posZ);
+        SetCellProp(gridStruct, currentCell, CELL_NET_SINK_UNCONN);
+    }
+
+    //3. Clear out whatever is left of the engine's state
+    ResetCellExpansion(gridStruct);
+    gridStruct->expansionList.clear();
+    gridStruct->currentExpansion = 0;
+    gridStruct->lastRoute.clear();
+    gridStruct->lastCell = NULL;
+    gridStruct->netRoutedNodes[gridStruct->currentNet] = parsedInputStruct->nodes[gridStruct->currentNet].size() - 1;
+    gridStruct->currentNodes.clear();
+    gridStruct->currentEdges.clear();
+    gridStruct->currentNodePointer = NULL;
+    gridStruct->nextNodePointer = NULL;
+    gridStruct->directionIndex = DIR_IDX_NUM;
+}
+
+bool TimeBudgetExpired(gridStruct_t *gridStruct)
+{
+    // Once it's run out it stays out, so the rest of the attempt doesn't keep reading the clock
+    if(gridStruct->timeBudget > 0 && !gridStruct->budgetExpired)
+    {
+        gridStruct->budgetExpired = std::chrono::duration<double>(std::chrono::steady_clock::now() - gridStruct->budgetStart).count() >= gridStruct->timeBudget;
+    }
+    return gridStruct->budgetExpired;
+}
+
+bool ParseRetryPolicy(const char *name, retryPolicy_e *policy)
+{
+    if(strcmp(name, "shuffle") == 0)
+    {
+        *policy = RETRY_SHUFFLE;
+    }
+    else if(strcmp(name, "recent") == 0)
+    {
+        *policy = RETRY_RECENT;
+    }
+    else if(strcmp(name, "frequent") == 0)
+    {
+        *policy = RETRY_FREQUENT;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+}
+
+void RecordFailedNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    netFailure_t *failure;
+
+    // Nets are shuffled between attempts, so they're told apart by their pins
+    if(gridStruct->currentNet >= parsedInputStruct->nodes.size())
+    {
+        return;
+    }
+    failure = &gridStruct->netFailures[GetNetSignature(&parsedInputStruct->nodes[gridStruct->currentNet])];
+    failure->failures++;
+    failure->lastAttempt = gridStruct->currentRetries + 1;
+}
+
+void PromoteFailedNets(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i;
+    std::vector<std::pair<unsigned int, unsigned int>> ranks;
+    std::vector<std::vector<posStruct_t>> newNodes;
+    std::unordered_map<unsigned long long, netFailure_t>::iterator failure;
+
+    //1. Rank every net by the policy, nets that never failed rank 0
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        failure = gridStruct->netFailures.find(GetNetSignature(&parsedInputStruct->nodes[i]));
+        if(failure == gridStruct->netFailures.end())
+        {
+            ranks.push_back(std::make_pair(0u, i));
+        }
+        else
+        {
+            ranks.push_back(std::make_pair(gridStruct->retryPolicy == RETRY_RECENT ? failure->second.lastAttempt : failure->second.failures, i));
+        }
+    }
+
+    //2. Highest ranks first, nets that rank the same keep their shuffled order
+    std::stable_sort(ranks.begin(), ranks.end(), CompareFailureRanks);
+    for(i = 0; i < ranks.size(); i++)
+    {
+        newNodes.push_back(parsedInputStruct->nodes[ranks[i].second]);
+    }
+    parsedInputStruct->nodes = newNodes;
+}
+
+bool CompareFailureRanks(const std::pair<unsigned int, unsigned int> &rank0, const std::pair<unsigned int, unsigned int> &rank1)
+{
+    return rank0.first > rank1.first;
+}
+
+void ReservePinAccess(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, j, dir, escapeDir, freeNeighbours, mostFreeNeighbours, sideDir;
+    cellStruct_t *pinCell, *currentCell;
+    cellStruct_t *pinNeighbours[DIR_NUM];
+    cellStruct_t *neighbours[DIR_NUM];
+
+    // Every pin gets the free neighbour with the most free neighbours of its own as its escape, a cell only escapes one pin
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+        {
+            pinCell = GetCell(gridStruct, parsedInputStruct->nodes[i][j].posX, parsedInputStruct->nodes[i][j].posY, parsedInputStruct->nodes[i][j].posZ);
+            GetNeighbours(gridStruct, pinCell, pinNeighbours);
+            escapeDir = DIR_NUM;
+            mostFreeNeighbours = 0;
+            for(dir = DIR_NORTH; dir < DIR_NUM; dir++)
+            {
+                currentCell = pinNeighbours[dir];
+                if(currentCell == NULL || currentCell->currentCellProp != CELL_EMPTY || currentCell->escapeDir != DIR_NUM)
+                {
+                    continue;
+                }
+                GetNeighbours(gridStruct, currentCell, neighbours);
+                freeNeighbours = 0;
+                for(sideDir = DIR_NORTH; sideDir < DIR_NUM; sideDir++)
+                {
+                    if(neighbours[sideDir] != NULL && neighbours[sideDir]->currentCellProp == CELL_EMPTY)
+                    {
+                        freeNeighbours++;
+                    }
+                }
+                if(escapeDir == DIR_NUM || freeNeighbours > mostFreeNeighbours)
+                {
+                    escapeDir = dir;
+                    mostFreeNeighbours = freeNeighbours;
+                }
+            }
+            if(escapeDir != DIR_NUM)
+            {
+                pinNeighbours[escapeDir]->escapeDir = GetOppositeDirection(escapeDir);
+            }
+        }
+    }
+}
+
+void FindWalledInNets(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, j, dir;
+    bool walledIn;
+    unsigned long long cell;
+    posStruct_t *pin;
+    std::vector<int> occupancy;
+    long long steps[DIR_NUM];
+
+    //1. Mark what can never be routed through, obstructions and pins (with their net, a pin of the same net is a way in)
+    gridStruct->walledInNets.clear();
+    occupancy.assign((unsigned long long)parsedInputStruct->gridSizeZ * parsedInputStruct->gridSizeY * parsedInputStruct->gridSizeX, -1);
+    for(i = 0; i < parsedInputStruct->obstructions.size(); i++)
+    {
+        if(parsedInputStruct->obstructions[i].posZ < parsedInputStruct->gridSizeZ)
+        {
+            cell = ((unsigned long long)parsedInputStruct->obstructions[i].posZ * parsedInputStruct->gridSizeY + parsedInputStruct->obstructions[i].posY) * parsedInputStruct->gridSizeX + parsedInputStruct->obstructions[i].posX;
+            occupancy[cell] = -2;
+        }
+    }
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+        {
+            pin = &parsedInputStruct->nodes[i][j];
+            if(pin->posZ < parsedInputStruct->gridSizeZ)
+            {
+                cell = ((unsigned long long)pin->posZ * parsedInputStruct->gridSizeY + pin->posY) * parsedInputStruct->gridSizeX + pin->posX;
+                occupancy[cell] = i;
+            }
+        }
+    }
+
+    //2. A pin is walled in if every neighbour is off the grid, obstructed or another net's pin, no routing order can get to it
+    steps[DIR_NORTH] = -(long long)parsedInputStruct->gridSizeX;
+    steps[DIR_EAST] = 1;
+    steps[DIR_SOUTH] = parsedInputStruct->gridSizeX;
+    steps[DIR_WEST] = -1;
+    steps[DIR_UP] = (long long)parsedInputStruct->gridSizeX * parsedInputStruct->gridSizeY;
+    steps[DIR_DOWN] = -(long long)parsedInputStruct->gridSizeX * parsedInputStruct->gridSizeY;
+    for(i = 0; i < parsedInputStruct->nodes.size(); i++)
+    {
+        for(j = 0; j < parsedInputStruct->nodes[i].size(); j++)
+        {
+            pin = &parsedInputStruct->nodes[i][j];
+            if(pin->posZ >= parsedInputStruct->gridSizeZ)
+            {
+                continue;
+            }
+            cell = ((unsigned long long)pin->posZ * parsedInputStruct->gridSizeY + pin->posY) * parsedInputStruct->gridSizeX + pin->posX;
+            walledIn = true;
+            for(dir = DIR_NORTH; dir < DIR_NUM && walledIn; dir++)
+            {
+                if((dir == DIR_NORTH && pin->posY == 0) || (dir == DIR_EAST && pin->posX == parsedInputStruct->gridSizeX - 1) ||
+                    (dir == DIR_SOUTH && pin->posY == parsedInputStruct->gridSizeY - 1) || (dir == DIR_WEST && pin->posX == 0) ||
+                    (dir == DIR_UP && pin->posZ == parsedInputStruct->gridSizeZ - 1) || (dir == DIR_DOWN && pin->posZ == 0))
+                {
+                    continue;
+                }
+                walledIn = occupancy[cell + steps[dir]] == -2 || (occupancy[cell + steps[dir]] >= 0 && occupancy[cell + steps[dir]] != (int)i);
+            }
+            if(walledIn)
+            {
+                gridStruct->walledInNets[GetNetSignature(&parsedInputStruct->nodes[i])] = *pin;
+                if(gridStruct->verbose)
+                {
+                    printf("Pin %d, %d, %d is walled in, its net can't be routed\n", pin->posX, pin->posY, pin->posZ);
+                }
+            }
+        }
+    }
+    if(!gridStruct->walledInNets.empty())
+    {
+        printf("%d net(s) have a pin walled in by obstructions and other pins, they're routed last and can't be routed\n", (int)gridStruct->walledInNets.size());
+    }
+}
+
+bool IsNetWalledIn(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, unsigned int net)
+{
+    if(gridStruct->walledInNets.empty() || net >= parsedInputStruct->nodes.size())
+    {
+        return false;
+    }
+    return gridStruct->walledInNets.find(GetNetSignature(&parsedInputStruct->nodes[net])) != gridStruct->walledInNets.end();
+}
+
+bool IsReservedCell(gridStruct_t *gridStruct, cellStruct_t *cell)
+{
+    cellStruct_t *pinCell;
+
+    // An escape is held for its pin's net until the net is routed, other nets may only use it once they failed without it
+    // Most cells aren't escapes, so check that before looking up any neighbour
+    if(cell->escapeDir == DIR_NUM || gridStruct->reservationsLifted)
+    {
+        return false;
+    }
+    pinCell = GetNeighbour(gridStruct, cell, cell->escapeDir);
+    return GetCellNet(pinCell) != (int)gridStruct->currentNet && gridStruct->netRoutedNodes[GetCellNet(pinCell)] > 0;
+}
+
+bool FindBlockingNets(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, std::vector<bool> *victims)
+{
+    unsigned int i, dir, bucket, newCost, stepCost;
+    cellStruct_t *sourceCell, *currentCell, *nextCell, *sinkCell;
+    cellStruct_t *neighbours[DIR_NUM];
+    std::vector<posStruct_t> *netNodes;
+
+    netNodes = &parsedInputStruct->nodes[gridStruct->currentNet];
+
+    // Search out from the failed net's first node, letting the search pass through other nets' wires at a price
+    sourceCell = GetCell(gridStruct, (*netNodes)[0].posX, (*netNodes)[0].posY, (*netNodes)[0].posZ);
+    SetCellLabel(gridStruct, sourceCell, 0);
+    sourceCell->prevDir = DIR_NUM;
+    gridStruct->expansionList.push_back(std::vector<cellStruct_t*>(1, sourceCell));
+    sinkCell = NULL;
+
+    // Drain the cost buckets in order until we reach one of our unconnected pins
+    for(bucket = 0; bucket < gridStruct->expansionList.size() && sinkCell == NULL; bucket++)
+    {
+        for(i = 0; i < gridStruct->expansionList[bucket].size() && sinkCell == NULL; i++)
+        {
+            currentCell = gridStruct->expansionList[bucket][i];
+
+            // Skip stale entries for cells that were later reached more cheaply
+            if(GetCellLabel(gridStruct, currentCell) != (int)bucket)
+            {
+                continue;
+            }
+
+            GetNeighbours(gridStruct, currentCell, neighbours);
+            for(dir = DIR_NORTH; dir < DIR_NUM; dir++)
+            {
+                nextCell = neighbours[dir];
+
+                // Make sure we have a cell to look at
+                if(nextCell == NULL || nextCell == sourceCell)
+                {
+                    continue;
+                }
+                // Check if we've found one of our unconnected pins
+                else if(nextCell->currentCellProp == CELL_NET_SINK_UNCONN && GetCellNet(nextCell) == (int)gridStruct->currentNet)
+                {
+                    nextCell->prevDir = GetOppositeDirection(dir);
+                    sinkCell = nextCell;
+                    break;
+                }
+                // Free cells and what's left of our own route cost a single step
+                else if(nextCell->currentCellProp == CELL_EMPTY || GetCellNet(nextCell) == (int)gridStruct->currentNet)
+                {
+                    stepCost = 1;
+                }
+                // Other nets' wires can be ripped up
+                else if(nextCell->currentCellProp == CELL_NET_WIRE_CONN || nextCell->currentCellProp == CELL_NET_WIRE_UNCONN)
+                {
+                    stepCost = RIPUP_WIRE_COST;
+                }
+                // Obstructions and other nets' pins stay where they are
+                else
+                {
+                    continue;
+                }
+
+                newCost = bucket + stepCost;
+                // Only relax the cell if this is the first or a cheaper way to reach it
+                if(GetCellLabel(gridStruct, nextCell) == -1 || (int)newCost < GetCellLabel(gridStruct, nextCell))
+                {
+                    SetCellLabel(gridStruct, nextCell, newCost);
+                    nextCell->prevDir = GetOppositeDirection(dir);
+                    if(gridStruct->expansionList.size() <= newCost)
+                    {
+                        gridStruct->expansionList.resize(newCost + 1);
+                    }
+                    gridStruct->expansionList[newCost].push_back(nextCell);
+                }
+            }
+        }
+    }
+
+    // Walk back along the cheapest path and note every net whose wires are on it
+    if(sinkCell != NULL)
+    {
+        for(currentCell = GetNeighbour(gridStruct, sinkCell, sinkCell->prevDir); currentCell != sourceCell; currentCell = GetNeighbour(gridStruct, currentCell, currentCell->prevDir))
+        {
+            if((currentCell->currentCellProp == CELL_NET_WIRE_CONN || currentCell->currentCellProp == CELL_NET_WIRE_UNCONN) &&
+                GetCellNet(currentCell) != (int)gridStruct->currentNet)
+            {
+                (*victims)[GetCellNet(currentCell)] = true;
+            }
+        }
+        sinkCell->prevDir = DIR_NUM;
+    }
+
+    // Clean up after ourselves
+    ResetCellExpansion(gridStruct);
+    gridStruct->expansionList.clear();
+
+    return sinkCell != NULL;
+}
+
+bool RipUpBlockingNets(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, j, failedNet, keptNets, numRipped;
+    size_t block, blockSize;
+    cellStruct_t *currentCell;
+    cellStruct_t *currentBlock;
+    std::vector<bool> ripped;
+    std::vector<int> newIds;
+    std::vector<std::vector<posStruct_t>> newNodes;
+    std::vector<unsigned int> newRoutedNodes;
+
+    failedNet = gridStruct->currentNet;
+
+    // Clear out whatever is left of the failed expansion
+    ResetCellExpansion(gridStruct);
+    gridStruct->expansionList.clear();
+    gridStruct->currentExpansion = 0;
+
+    //1. Find the routed nets on the failed net's cheapest path, if there's no path at all ripping up won't help
+    ripped.assign(parsedInputStruct->nodes.size(), false);
+    if(!FindBlockingNets(parsedInputStruct, gridStruct, &ripped))
+    {
+        return false;
+    }
+    // The failed net starts over as well
+    ripped[failedNet] = true;
+
+    //2. Work out the new net order: the untouched routed nets, the failed net, the nets we ripped up, then the nets we haven't reached yet
+    newIds.assign(parsedInputStruct->nodes.size(), -1);
+    for(i = 0; i < failedNet; i++)
+    {
+        if(!ripped[i])
+        {
+            newIds[i] = newNodes.size();
+            newNodes.push_back(parsedInputStruct->nodes[i]);
+            newRoutedNodes.push_back(gridStruct->netRoutedNodes[i]);
+        }
+    }
+    keptNets = newNodes.size();
+    newIds[failedNet] = newNodes.size();
+    newNodes.push_back(parsedInputStruct->nodes[failedNet]);
+    newRoutedNodes.push_back(parsedInputStruct->nodes[failedNet].size() - 1);
+    for(i = 0; i < failedNet; i++)
+    {
+        if(ripped[i])
+        {
+            newIds[i] = newNodes.size();
+            newNodes.push_back(parsedInputStruct->nodes[i]);
+            newRoutedNodes.push_back(parsedInputStruct->nodes[i].size() - 1);
+        }
+    }
+    for(i = failedNet + 1; i < parsedInputStruct->nodes.size(); i++)
+    {
+        newIds[i] = newNodes.size();
+        newNodes.push_back(parsedInputStruct->nodes[i]);
+        newRoutedNodes.push_back(gridStruct->netRoutedNodes[i]);
+    }
+    numRipped = newNodes.size() - keptNets - (parsedInputStruct->nodes.size() - failedNet);
+
+    //3. Remove the ripped up nets' wires, disconnect their pins and renumber every cell to the new order
+    for(block = 0; block < GetNumCellBlocks(gridStruct); block++)
+    {
+        currentBlock = GetCellBlock(gridStruct, block, &blockSize);
+        for(j = 0; j < blockSize; j++)
+        {
+            currentCell = &currentBlock[j];
+
+            if(GetCellNet(currentCell) < 0)
+            {
+                continue;
+            }
+            if(ripped[GetCellNet(currentCell)])
+            {
+                if(currentCell->currentCellProp == CELL_NET_WIRE_CONN || currentCell->currentCellProp == CELL_NET_WIRE_UNCONN)
+                {
+                    SetCellProp(gridStruct, currentCell, CELL_EMPTY);
+                    SetCellNet(gridStruct, currentCell, -1);
+                    continue;
+                }
+                else if(currentCell->currentCellProp == CELL_NET_SINK_CONN)
+                {
+                    SetCellProp(gridStruct, currentCell, CELL_NET_SINK_UNCONN);
+                }
+            }
+            SetCellNet(gridStruct, currentCell, newIds[GetCellNet(currentCell)]);
+        }
+        ReleaseCellBlock(gridStruct, block);
+    }
+    parsedInputStruct->nodes = newNodes;
+    gridStruct->netRoutedNodes = newRoutedNodes;
+
+    //4. Pick up again at the failed net
+    gridStruct->currentNet = keptNets;
+    gridStruct->lastRoute.clear();
+    gridStruct->lastCell = NULL;
+    gridStruct->currentNodes.clear();
+    gridStruct->currentEdges.clear();
+    gridStruct->currentNodePointer = NULL;
+    gridStruct->nextNodePointer = NULL;
+    gridStruct->directionIndex = DIR_IDX_NUM;
+    printf("Ripped up %d net(s) blocking net %d, rerouting from net %d\n", numRipped, failedNet, keptNets);
+
+    return true;
+}
+
+unsigned long long HashCombine(unsigned long long hash, unsigned long long value)
+{
+    // FNV-1a, one byte at a time
+    unsigned int i;
+
+    for(i = 0; i < sizeof(value); i++)
+    {
+        hash ^= (value >> (i * 8)) & 0xFF;
+        hash *= 0x100000001B3ULL;
+    }
+
+    return hash;
+}
+
+unsigned long long GetNetSignature(std::vector<posStruct_t> *netNodes)
+{
+    unsigned int i;
+    unsigned long long hash;
+    std::vector<unsigned long long> pins;
+
+    // Net ids change every time the net order is shuffled, so a net is identified by its pins instead
+    for(i = 0; i < netNodes->size(); i++)
+    {
+        pins.push_back(((unsigned long long)(*netNodes)[i].posZ << 48) | ((unsigned long long)(*netNodes)[i].posX << 24) | (*netNodes)[i].posY);
+    }
+    std::sort(pins.begin(), pins.end());
+
+    hash = ROUTE_CACHE_HASH_SEED;
+    for(i = 0; i < pins.size(); i++)
+    {
+        hash = HashCombine(hash, pins[i]);
+    }
+
+    return hash;
+}
+
+unsigned long long GetWindowHash(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i, x, y, z, minX, minY, maxX, maxY;
+    unsigned long long hash;
+    cellStruct_t *currentCell;
+    std::vector<posStruct_t> *netNodes;
+
+    netNodes = &parsedInputStruct->nodes[gridStruct->currentNet];
+
+    // The search window is the bounding box of the net's pins plus a margin
+    minX = maxX = (*netNodes)[0].posX;
+    minY = maxY = (*netNodes)[0].posY;
+    for(i = 1; i < netNodes->size(); i++)
+    {
+        minX = std::min(minX, (*netNodes)[i].posX);
+        maxX = std::max(maxX, (*netNodes)[i].posX);
+        minY = std::min(minY, (*netNodes)[i].posY);
+        maxY = std::max(maxY, (*netNodes)[i].posY);
+    }
+    minX = (minX > ROUTE_CACHE_WINDOW_MARGIN) ? minX - ROUTE_CACHE_WINDOW_MARGIN : 0;
+    minY = (minY > ROUTE_CACHE_WINDOW_MARGIN) ? minY - ROUTE_CACHE_WINDOW_MARGIN : 0;
+    maxX = std::min(maxX + ROUTE_CACHE_WINDOW_MARGIN, gridStruct->gridSizeX - 1);
+    maxY = std::min(maxY + ROUTE_CACHE_WINDOW_MARGIN, gridStruct->gridSizeY - 1);
+
+    // Fold in every cell in the window that another net or an obstruction is using
+    hash = ROUTE_CACHE_HASH_SEED;
+    for(z = 0; z < gridStruct->gridSizeZ; z++)
+    {
+        for(x = minX; x <= maxX; x++)
+        {
+            for(y = minY; y <= maxY; y++)
+            {
+                currentCell = GetCell(gridStruct, x, y, z);
+                if(currentCell->currentCellProp != CELL_EMPTY && GetCellNet(currentCell) != (int)gridStruct->currentNet)
+                {
+                    hash = HashCombine(hash, (z * gridStruct->gridSizeX + x) * gridStruct->gridSizeY + y);
+                }
+            }
+        }
+    }
+
+    return hash;
+}
+
+void StoreCachedRoute(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i;
+    routeCacheEntry_t entry;
+    posStruct_t pos;
+
+    // Keep the wires of the route we just finished along with what its surroundings looked like
+    entry.windowHash = gridStruct->currentWindowHash;
+    for(i = 0; i < gridStruct->lastRoute.size(); i++)
+    {
+        if(gridStruct->lastRoute[i]->currentCellProp == CELL_NET_WIRE_CONN)
+        {
+            GetCellPos(gridStruct, gridStruct->lastRoute[i], &pos);
+            entry.path.push_back(pos);
+        }
+    }
+
+    gridStruct->routeCache[GetNetSignature(&parsedInputStruct->nodes[gridStruct->currentNet])] = entry;
+}
+
+bool ReplayCachedRoute(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct)
+{
+    unsigned int i;
+    cellStruct_t *currentCell;
+    std::vector<posStruct_t> *netNodes;
+    std::unordered_map<unsigned long long, routeCacheEntry_t>::iterator entry;
+
+    netNodes = &parsedInputStruct->nodes[gridStruct->currentNet];
+
+    // We need a cached route that was found with the same surroundings
+    entry = gridStruct->routeCache.find(GetNetSignature(netNodes));
+    if(entry == gridStruct->routeCache.end() || entry->second.windowHash != gridStruct->currentWindowHash)
+    {
+        return false;
+    }
+
+    // The route may leave the window, so make sure every one of its cells is still free and isn't held for another net's pin
+    for(i = 0; i < entry->second.path.size(); i++)
+    {
+        currentCell = GetCell(gridStruct, entry->second.path[i].posX, entry->second.path[i].posY, entry->second.path[i].posZ);
+        if(currentCell->currentCellProp != CELL_EMPTY || IsReservedCell(gridStruct, currentCell))
+        {
+            return false;
+        }
+    }
+
+    // Lay the route back down
+    for(i = 0; i < entry->second.path.size(); i++)
+    {
+        currentCell = GetCell(gridStruct, entry->second.path[i].posX, entry->second.path[i].posY, entry->second.path[i].posZ);
+        SetCellNet(gridStruct, currentCell, gridStruct->currentNet);
+        SetCellProp(gridStruct, currentCell, CELL_NET_WIRE_CONN);
+        gridStruct->lastRoute.push_back(currentCell);
+    }
+    for(i = 0; i < netNodes->size(); i++)
+    {
+        currentCell = GetCell(gridStruct, (*netNodes)[i].posX, (*netNodes)[i].posY, (*netNodes)[i].posZ);
+        if(currentCell->currentCellProp == CELL_NET_SINK_UNCONN)
+        {
+            SetCellProp(gridStruct, currentCell, CELL_NET_SINK_CONN);
+        }
+        gridStruct->lastRoute.push_back(currentCell);
+    }
+    gridStruct->netRoutedNodes[gridStruct->currentNet] = 0;
+    gridStruct->routeCacheHits++;
+    // Every retry replays the same routes, so only list them when we're verbose
+    if(gridStruct->verbose)
+    {
+        printf("Replayed cached route for net %d\n", gridStruct->currentNet);
+    }
+
+    return true;
+}
+
+cardinalDir_e GetOppositeDirection(unsigned int dir)
+{
+    switch(dir)
+    {
+        case DIR_NORTH:
+            return DIR_SOUTH;
+        case DIR_EAST:
+            return DIR_WEST;
+        case DIR_SOUTH:
+            return DIR_NORTH;
+        case DIR_WEST:
+            return DIR_EAST;
+        case DIR_UP:
+            return DIR_DOWN;
+        case DIR_DOWN:
+            return DIR_UP;
+        default:
+            return DIR_NUM;
+    }
+}
+
+void ActOnButtonPress(float x, float y)
+{
+    /* Called whenever event_loop gets a button press in the graphics *
+     * area.  Allows the user to do whatever he/she wants with button *
+     * clicks.                                                        */
+    printf("User clicked a button at coordinates (%f, %f)\n", x, y);
+}
+
+void ActOnMouseMove(float x, float y)
+{
+    // function to handle mouse move event, the current mouse position in the current world coordinate
+    // as defined as MAX_X and MAX_Y in init_world is returned
+    printf("Mouse move at (%f,%f)\n", x, y);
+}
+
+void ActOnKeyPress(char c)
+{
+    char strBuff[80];
+
+    // function to handle keyboard press event, the ASCII character is returned
+    printf("Key press: %c\n", c);
+
+    // Only the layer on screen can change while routing in the background
+    if(routingThread.joinable() && c != 'C' && c != 'L')
+    {
+        update_message("Still routing... press C to cancel");
+        return;
+    }
+
+    switch(c)
+    {
+        case 'R':
+            printf("Resetting grid! \n");
+            // Initialize the router
+            RouterInit(input, grid);
+            RestoreSavedRouting(input, grid);
+            break;
+        case 'N':
+            printf("Taking a single step...\n");
+            RouterExec(input, grid, STEP_SINGLE);
+            break;
+        case 'M':
+            printf("Attempting to route a single net...\n");
+            StartRoutingThread(input, grid, STEP_NET);
+            break;
+        case 'A':
+            printf("Attempting to route the entire grid...\n");
+            StartRoutingThread(input, grid, STEP_COMPLETE);
+            break;
+        case 'C':
+            // Stop routing, N, M and A carry on from where it stopped
+            printf("Cancelling routing...\n");
+            StopRoutingThread();
+            break;
+        case 'W':
+            grid->weighted = !grid->weighted;
+            printf("Weighted routing %s, resetting grid! \n", grid->weighted ? "enabled" : "disabled");
+            // Cached routes were found with the other cost model
+            grid->routeCache.clear();
+            // Initialize the router
+            RouterInit(input, grid);
+            RestoreSavedRouting(input, grid);
+            break;
+        case 'L':
+            // Cycle through the routing layers on screen
+            displayLayer = (displayLayer + 1) % input->gridSizeZ;
+            sprintf(strBuff, "Showing layer %d of %d", displayLayer, input->gridSizeZ);
+            update_message(strBuff);
+            break;
+        default:
+            break;
+    }
+
+    // redraw what changed on screen
+    UpdateScreen();
+}
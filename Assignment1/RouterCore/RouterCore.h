@@ -0,0 +1,668 @@
+#pragma once
+
+#include <chrono>
+#include <cstdio>
+#include <ctime>
+#include <deque>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <random>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include "graphics.h"
+
+// Constants used in drawing
+
+#define BACKGROUND_COLOR        BLACK
+#define GRID_COLOR				DARKGREY
+#define OBSTRUCTION_COLOR		LIGHTGREY
+#define MAX_NET_COLORS          8
+#define ROUTING_FRAME_MS        50  ///< How often the window redraws the routing thread's latest snapshot
+#define LOD_MIN_TEXT_PIXELS     16  ///< Cells smaller than this on screen are drawn without their labels and numbers
+#define LOD_MIN_OUTLINE_PIXELS  4   ///< Cells smaller than this on screen are drawn without the outlines of empty cells
+
+// Constants used in image export
+#define IMAGE_CELL_PIXELS       4       ///< Default width and height of a cell in exported images
+#define PNG_STORED_BLOCK_SIZE   65535   ///< Largest stored (uncompressed) deflate block
+
+// Constants used in the algorithm
+#define LEE_MOORE_ROUTING_RETRIES       50  ///< Retries before Lee Moore (and racing, which falls back to it) gives up on a grid
+#define LINE_PROBE_ROUTING_RETRIES      500 ///< Retries before line probing gives up on a grid, its attempts are cheap but hit or miss
+#define CHANNEL_ROUTING_RETRIES         50  ///< Retries before channel routing (which falls back to Lee Moore) gives up on a grid
+
+// Constants used in rip-up and reroute
+#define MAXIMUM_RIPUPS_PER_ATTEMPT      20  ///< Rip-ups allowed before giving up on an attempt and restarting
+#define RIPUP_WIRE_COST                 8   ///< Cost of passing through another net's wire when looking for nets to rip up
+
+// Constants used in the route cache
+#define ROUTE_CACHE_WINDOW_MARGIN       2                       ///< Cells around a net's pins that make up its search window
+#define ROUTE_CACHE_HASH_SEED           0xCBF29CE484222325ULL   ///< FNV-1a offset basis
+
+// Constants used in the binary grid format
+#define BINARY_GRID_MAGIC               0x44524752  ///< "RGRD" when read as a little endian integer
+#define BINARY_GRID_VERSION             1
+
+// Constants used in the cell storage
+#define GRID_TILE_SIZE                  16  ///< Width and height of the square tiles of cells stored together in the tiled layout
+#define GRID_FILE_RESIDENT_TILES        4096    ///< Tiles of a grid file kept resident between nets when it isn't given
+
+// Constants used in the packed cells
+#define CELL_NO_NET                     0       ///< A cell's packed net when no net has been routed through it
+#define CELL_MAX_NETS                   0x7FFFFFFF  ///< Nets are stored offset by one so CELL_NO_NET stays free, and must still fit the int net numbers
+
+// Constants used in domain decomposition
+#define DOMAIN_HALO_WIDTH               8   ///< Cells of its neighbours' domains a worker sees around its own, nets reaching no further than this are routed by the workers
+#define DOMAIN_HALO_PHASES              4   ///< The domains route into their halos in turns, coloured like a checkerboard so no two neighbours route at once
+
+// Constants used in weighted routing
+#define WEIGHT_CELL_BASE                1   ///< Base cost of routing through an empty cell
+#define WEIGHT_BEND                     2   ///< Cost of changing direction
+#define WEIGHT_OBSTRUCTION_PROXIMITY    1   ///< Added cost for each obstructed neighbour of a cell
+#define WEIGHT_PIN_PROXIMITY            3   ///< Added cost for each source or sink neighbouring a cell
+#define WEIGHT_VIA                      4   ///< Cost of a via between routing layers
+#define WEIGHT_WRONG_WAY                2   ///< Added cost for stepping against a layer's preferred direction
+#define WEIGHT_CONGESTION               1   ///< Added cost for each neighbouring cell another net has already routed a wire through
+
+// This enum contains the routing state, the engines step through the states of a net and the core through the rest
+typedef enum
+{
+    STATE_IDLE = 0,     ///< Ready to start the next net
+    STATE_SEEK,         ///< Probing a line towards the next pin (line probe)
+    STATE_EXPANSION,    ///< Expanding towards the next pin
+    STATE_WALKBACK,     ///< Walking back from the pin we reached (Lee Moore)
+    STATE_RIPUP,
+    STATE_ROUTE_SUCCESS,
+    STATE_ROUTE_FAILURE
+} routingState_e;
+
+// This enum contains the ways the nets are ordered on every retry
+typedef enum
+{
+    RETRY_SHUFFLE = 0,  ///< Every attempt shuffles the nets
+    RETRY_RECENT,       ///< The nets that failed most recently go first, the rest are shuffled behind them
+    RETRY_FREQUENT      ///< The nets that failed in the most attempts go first, the rest are shuffled behind them
+} retryPolicy_e;
+
+// This enum contains the planes of a grid file, each holds a whole grid's tiles
+typedef enum
+{
+    PLANE_CELLS = 0,    ///< The grid being routed
+    PLANE_PRISTINE,     ///< The grid before any routing, restored on every attempt
+    PLANE_BEST,         ///< The best grid so far
+    PLANE_LABELS,       ///< The expansion numbers of the grid being routed, one int per cell in the same places as its cells
+    PLANE_NUM
+} gridPlane_e;
+
+// This enum contains the messages between the domain coordinator and its workers
+typedef enum
+{
+    DOMAIN_MSG_PROBLEM = 0, ///< Coordinator to worker: the domain's window, its obstructions and its nets
+    DOMAIN_MSG_ROUTE,       ///< Coordinator to worker: route a phase's nets, after taking in the cells routed by the other workers
+    DOMAIN_MSG_ROUTED,      ///< Worker to coordinator: the nets routed in the phase and their wires
+    DOMAIN_MSG_DONE         ///< Coordinator to worker: nothing left to route, exit
+} domainMessage_e;
+
+// This enum contains the routing options sent to the domain workers
+typedef enum
+{
+    DOMAIN_OPTION_WEIGHTED = 1,
+    DOMAIN_OPTION_RIPUP = 2,
+    DOMAIN_OPTION_ROUTE_CACHE = 4,
+    DOMAIN_OPTION_TILED = 8,
+    DOMAIN_OPTION_VERBOSE = 16,
+    DOMAIN_OPTION_PIN_ACCESS = 32
+} domainOption_e;
+
+// This enum contains property information about a cell
+typedef enum
+{
+    CELL_EMPTY = 0,
+    CELL_OBSTRUCTED,
+    CELL_NET_SOURCE,
+    CELL_NET_SINK_UNCONN,
+    CELL_NET_SINK_CONN,
+    CELL_NET_WIRE_UNCONN,
+    CELL_NET_WIRE_CONN
+} cellProp_e;
+
+// This enum defines how large of a step to take in the algorithm
+typedef enum
+{
+    STEP_SINGLE = 0,    ///< Step only a single step
+    STEP_NET,           ///< Step an entire net (route a net and go to the next one)
+    STEP_COMPLETE       ///< Attempt to route the entire grid
+} stepType_e;
+
+// This enum is a counter incrementing for each cardinal direction, followed by the via directions between layers
+typedef enum
+{
+    DIR_NORTH = 0,
+    DIR_EAST,
+    DIR_SOUTH,
+    DIR_WEST,
+    DIR_UP,             ///< Via to the next layer up
+    DIR_DOWN,           ///< Via to the next layer down
+    DIR_NUM
+} cardinalDir_e;
+
+// Macros to help index the current direction we are in
+typedef enum
+{
+    DIR_IDX_NS_Y = 0,
+    DIR_IDX_EW_X,
+    DIR_IDX_UD_Z,
+    DIR_IDX_NUM
+} directionIndex_e;
+
+// This enum contains a routing layer's preferred direction
+typedef enum
+{
+    PREF_DIR_NONE = 0,  ///< No preferred direction (single layer grids)
+    PREF_DIR_HORIZONTAL,
+    PREF_DIR_VERTICAL
+} preferredDir_e;
+
+// This struct stores an X, Y position and the routing layer it's on
+typedef struct
+{
+    unsigned int posX;
+    unsigned int posY;
+    unsigned int posZ;
+
+} posStruct_t;
+
+// This struct contains a cell's properties, packed so expansions stream as few bytes as possible
+// A cell's coordinates and neighbours follow from where it's stored and its expansion number lives in the label plane, so always go through the accessors for those
+typedef struct
+{
+    unsigned int    net;                    ///< This is the current routed net plus one, CELL_NO_NET if there's none (use GetCellNet and SetCellNet)
+    unsigned short  cost;                   ///< This is the cost of routing through this cell in weighted mode
+    unsigned short  currentCellProp : 3;    ///< This is the current cell's property (cellProp_e)
+    unsigned short  prevDir : 3;            ///< This is the direction back to the cell we were expanded from in weighted mode and when searching for nets to rip up (cardinalDir_e)
+    unsigned short  escapeDir : 3;          ///< This is the direction of the pin this cell is reserved as an escape for (DIR_NUM if it isn't reserved)
+} cellStruct_t;
+
+typedef struct
+{
+    // Input file storage
+    unsigned int                            gridSizeX;          ///< The grid size in X
+    unsigned int                            gridSizeY;          ///< The grid size in Y
+    unsigned int                            gridSizeZ;          ///< The number of routing layers
+
+    std::vector<posStruct_t>                obstructions;       ///< This contains all of the obstructions
+    std::vector<std::vector<posStruct_t>>   nodes;              ///< This contains all of the nets and their sources and sinks
+} parsedInputStruct_t;
+
+// This struct holds a read-only mapping of a whole file
+typedef struct
+{
+    const char                              *data;              ///< The file's contents (not null terminated)
+    size_t                                  size;               ///< The file's size in bytes
+#ifdef WIN32
+    HANDLE                                  fileHandle;         ///< The open file
+    HANDLE                                  mapHandle;          ///< The file mapping object
+#else
+    int                                     fileDescriptor;     ///< The open file
+#endif
+} mappedFile_t;
+
+// This struct holds a grid's cells in a file instead of memory, tile by tile, with only a working set of the tiles resident
+typedef struct
+{
+    char                                    *data;              ///< The mapped file, PLANE_NUM planes of numTiles tiles each
+    size_t                                  size;               ///< The file's size in bytes
+    size_t                                  tileStride;         ///< Bytes per tile, rounded up to whole pages so every tile can be dropped on its own
+    size_t                                  numTiles;           ///< The number of tiles in each plane
+    unsigned int                            maxResident;        ///< The most tiles of the grid being routed kept resident between nets
+    std::list<size_t>                       lruTiles;           ///< The tiles in the working set, most recently used first
+    std::vector<std::list<size_t>::iterator> lruPositions;      ///< Every tile's place in the working set (only valid if it's in it)
+    std::vector<bool>                       inWorkingSet;       ///< Whether each tile is in the working set
+    std::vector<bool>                       tileChanged;        ///< Whether each tile of the grid being routed has been used since the best grid was saved
+    std::vector<size_t>                     changedTiles;       ///< The tiles used since the best grid was saved, only these are copied when it's saved again
+    bool                                    allChanged;         ///< Whether the whole grid may have changed since the best grid was saved (after a new attempt or a rip-up)
+#ifdef WIN32
+    HANDLE                                  fileHandle;         ///< The open file
+    HANDLE                                  mapHandle;          ///< The file mapping object
+#else
+    int                                     fileDescriptor;     ///< The open file
+#endif
+} gridFile_t;
+
+// This struct is the header of a binary grid file, the sections it points to follow it in the file
+typedef struct
+{
+    unsigned int            magic;              ///< Always BINARY_GRID_MAGIC
+    unsigned int            version;            ///< Always BINARY_GRID_VERSION
+    unsigned int            gridSizeX;          ///< The grid size in X
+    unsigned int            gridSizeY;          ///< The grid size in Y
+    unsigned int            gridSizeZ;          ///< The number of routing layers
+    unsigned int            numNets;            ///< The number of entries in the net table
+    unsigned int            numPins;            ///< The number of entries in the pin table
+    unsigned int            netsRouted;         ///< The number of nets that were routed when the grid was saved
+    unsigned long long      obstructionOffset;  ///< Offset of the obstruction bitmap, one bit per cell in (z, y, x) order
+    unsigned long long      netOffset;          ///< Offset of the net table, one binaryGridNet_t per net
+    unsigned long long      pinOffset;          ///< Offset of the pin table, one posStruct_t per pin, grouped by net
+    unsigned long long      netPlaneOffset;     ///< Offset of the net id plane, one int per cell in (z, y, x) order (-1 if empty), or 0 if the grid wasn't routed
+} binaryGridHeader_t;
+
+// This struct is an entry of a binary grid file's net table
+typedef struct
+{
+    unsigned int            numPins;            ///< The number of the net's pins in the pin table
+    unsigned int            routed;             ///< 1 if the net was routed when the grid was saved, 0 otherwise
+} binaryGridNet_t;
+
+// This struct contains a routing loaded from a binary grid, waiting to be restored into the cells
+typedef struct
+{
+    std::vector<int>                        netPlane;           ///< Every cell's saved net id (indexed by the saved net order)
+    std::vector<posStruct_t>                netPins;            ///< A pin of each saved net, to find the net again after the nets have been shuffled
+    std::vector<bool>                       netRouted;          ///< Whether each saved net was routed
+} savedRouting_t;
+
+// This struct contains a cached route for a net
+typedef struct
+{
+    unsigned long long                      windowHash;         ///< Hash of the blocked cells in the net's search window when it was routed
+    std::vector<posStruct_t>                path;               ///< The wire cells of the route
+} routeCacheEntry_t;
+
+// This struct contains a routing channel, a band of rows without obstructions between rows of cells
+typedef struct
+{
+    unsigned int                            posZ;               ///< The routing layer the channel is on
+    unsigned int                            top;                ///< The channel's first row
+    unsigned int                            bottom;             ///< The channel's last row
+} routingChannel_t;
+
+// This struct contains a net's connection of its pins within a channel, a trunk along one of the channel's rows and a branch from every pin to it
+typedef struct
+{
+    unsigned int                            channel;            ///< The channel the pins are in
+    unsigned int                            net;                ///< The net in the attempt's starting net order (rip-ups renumber the nets, so only used while planning)
+    unsigned int                            left;               ///< The leftmost pin's X
+    unsigned int                            right;              ///< The rightmost pin's X
+    bool                                    planned;            ///< Whether the connection got a track, it's left to Lee Moore otherwise
+    unsigned int                            track;              ///< The row the trunk runs along (only if planned)
+    std::vector<posStruct_t>                pins;               ///< The net's pins in the channel
+    std::vector<posStruct_t>                path;               ///< The trunk and branch cells, pins excluded (only if planned)
+} channelSegment_t;
+
+// This struct is the header of every message between the domain coordinator and its workers, the values it counts follow it
+typedef struct
+{
+    unsigned int                            type;               ///< The message (domainMessage_e)
+    unsigned int                            length;             ///< The number of unsigned int values following the header, positions are always in the whole grid's coordinates
+} domainMessageHeader_t;
+
+// This struct contains a rectangle of the grid routed by its own worker process, with a halo of its neighbours' cells around it
+typedef struct
+{
+    unsigned int                            left;               ///< The domain's first column
+    unsigned int                            top;                ///< The domain's first row
+    unsigned int                            right;              ///< One past the domain's last column
+    unsigned int                            bottom;             ///< One past the domain's last row
+    unsigned int                            windowLeft;         ///< The first column of the domain and its halo
+    unsigned int                            windowTop;          ///< The first row of the domain and its halo
+    unsigned int                            windowRight;        ///< One past the last column of the domain and its halo
+    unsigned int                            windowBottom;       ///< One past the last row of the domain and its halo
+    unsigned int                            haloPhase;          ///< The phase the domain routes into its halo in, from 1 to DOMAIN_HALO_PHASES
+    std::vector<unsigned int>               nets;               ///< The nets the domain's worker routes
+    std::vector<posStruct_t>                haloUpdates;        ///< The cells in the window routed by other workers since the worker was last told
+    int                                     socket;             ///< The coordinator's end of the worker's socket (-1 once the worker is gone)
+    int                                     processId;          ///< The worker process
+} routingDomain_t;
+
+// This struct contains a net's failures across attempts
+typedef struct
+{
+    unsigned int                            failures;           ///< The number of attempts the net failed in
+    unsigned int                            lastAttempt;        ///< The last attempt the net failed in, counting from 1
+} netFailure_t;
+
+// This struct contains the telemetry recorded while routing a net
+typedef struct
+{
+    unsigned int                            net;                ///< The net's index in its attempt's net order
+    posStruct_t                             source;             ///< The net's first pin, to tell nets apart across attempts
+    unsigned int                            pins;               ///< The net's number of pins
+    unsigned int                            attempt;            ///< The attempt (retry) the net was routed in
+    bool                                    routed;             ///< Whether the net was routed
+    unsigned long long                      cellsExpanded;      ///< The number of cells labelled by the net's expansions
+    unsigned int                            expansionLayers;    ///< The number of expansion layers (or cost buckets in weighted mode)
+    unsigned long long                      frontierPeak;       ///< The largest expansion layer (or cost bucket)
+    unsigned int                            walkbackLength;     ///< The number of cells walked back over
+    double                                  wallTime;           ///< Wall clock time spent on the net, in seconds
+    double                                  cpuTime;            ///< CPU time spent on the net, in seconds
+
+    bool                                    active;             ///< Whether the net is being recorded
+    std::chrono::steady_clock::time_point   startTime;          ///< When we started routing the net
+    std::clock_t                            startClock;         ///< The CPU clock when we started routing the net
+} netTelemetry_t;
+
+// This struct contains a batch job, one per input file, and its results
+typedef struct
+{
+    std::string                             filename;           ///< The input file
+    bool                                    parsed;             ///< Whether the input was parsed, the rest is only filled in if it was
+    unsigned int                            gridSizeX;          ///< The grid size in X
+    unsigned int                            gridSizeY;          ///< The grid size in Y
+    unsigned int                            gridSizeZ;          ///< The number of routing layers
+    unsigned int                            nets;               ///< The number of nets
+    unsigned int                            netsRouted;         ///< The number of nets routed, or the most we managed at once if routing failed
+    unsigned int                            retries;            ///< The number of retries it took
+    bool                                    routed;             ///< Whether every net was routed
+    double                                  wallTime;           ///< Wall clock time spent on the job, in seconds
+    unsigned int                            seed;               ///< The seed of the job's net order shuffling, so its result doesn't depend on which worker routes it
+} batchJob_t;
+
+// This struct contains a batch worker's queue of jobs
+typedef struct
+{
+    std::mutex                              lock;               ///< Guards the queue, other workers steal from it
+    std::deque<unsigned int>                jobs;               ///< The jobs left, the owner takes from the front and thieves from the back
+} batchQueue_t;
+
+// This struct contains what's drawn of a cell
+typedef struct
+{
+    cellProp_e                              currentCellProp;    ///< This is the cell's property
+    int                                     currentNet;         ///< This is the cell's routed net
+    int                                     currentNumber;      ///< This is the cell's expansion number
+} cellSnapshot_t;
+
+// This struct contains a copy of the grid published by the routing thread, it's never changed once published
+typedef struct
+{
+    unsigned int                            gridSizeX;          ///< The grid size in X
+    unsigned int                            gridSizeY;          ///< The grid size in Y
+    unsigned int                            gridSizeZ;          ///< The number of routing layers
+    std::vector<cellSnapshot_t>             cells;              ///< Every cell, in (z, y, x) order
+    std::string                             message;            ///< The router's status when the snapshot was taken
+} gridSnapshot_t;
+
+struct Engine;
+
+typedef struct
+{
+    // Routing variables
+    const Engine                                            *engine;            ///< The engine routing the grid
+    const Engine                                            *netEngine;         ///< The engine routing the current net (the engine's fallback once it gave up on the net)
+    unsigned int                                            fallbackNets;       ///< A counter for the nets handed over to a fallback engine
+    unsigned int                                            currentNet;         ///< The current net being routed
+    std::vector<unsigned int>                               netRoutedNodes;     ///< A counter for every net to keep track of how many nodes left to route
+    cellStruct_t                                            *lastCell;          ///< A pointer for the last cell to walk back from
+    int                                                     currentExpansion;   ///< The current expansion layer
+    std::vector<std::vector<cellStruct_t*>>                 expansionList;      ///< A list containing the cells in the current expansion layer
+    std::vector<cellStruct_t*>                              lastRoute;          ///< Keep a list of the net's route so far, to route additional sinks from and to take back if the net fails
+    routingState_e                                          currentRoutingState;///< The current routing state
+    unsigned int                                            currentRetries;     ///< A counter for additional attempts to route a grid
+    bool                                                    ripUp;              ///< On failure, rip up only the nets blocking the failed net instead of restarting
+    unsigned int                                            currentRipUps;      ///< A counter for the rip-ups in the current attempt
+    bool                                                    verbose;            ///< Print the details of every routing step (slows down complete routes)
+    bool                                                    weighted;           ///< Use weighted cell costs with a bucket (Dial) queue instead of unit expansion layers (Lee Moore only)
+
+    // Time budget and retries
+    double                                                  timeBudget;         ///< Stop retrying and settle for the best grid after this many seconds (0 for no budget)
+    std::chrono::steady_clock::time_point                   budgetStart;        ///< When the first attempt started
+    bool                                                    budgetExpired;      ///< Whether the time budget ran out before routing finished
+    unsigned long long                                      expansionCap;       ///< Give up on a net once its expansions have labelled this many cells (0 for no cap)
+    retryPolicy_e                                           retryPolicy;        ///< How the nets are ordered on every retry
+    std::unordered_map<unsigned long long, netFailure_t>    netFailures;        ///< Every net's failures so far, keyed by the net's pin signature
+    unsigned int                                            seed;               ///< The seed of the net order shuffling, batch jobs and domains add their own index to it
+    std::mt19937                                            rng;                ///< Shuffles the net and pin order, every grid has its own so batch jobs and domain workers never share one
+
+    // Pin access
+    bool                                                    reservePinAccess;   ///< Reserve an escape cell next to every pin for its net, and route the nets with a walled in pin last
+    bool                                                    reservationsLifted; ///< Whether the current net is routing through the other nets' escape cells (once it failed without them)
+    std::unordered_map<unsigned long long, posStruct_t>     walledInNets;       ///< The nets with a pin that only obstructions and other nets' pins surround, keyed by the net's pin signature, with the pin
+
+    // Line probe variables
+    std::vector<cellStruct_t*>                              currentNodes;       ///< a list of the net's current nodes
+    std::vector<std::pair<cellStruct_t*, cellStruct_t*>>    currentEdges;       ///< Store the edges for the current net connections
+    cellStruct_t                                            *currentNodePointer;///< A pointer to the current node
+    cardinalDir_e                                           nextNodeDir[DIR_IDX_NUM];///< The direction of the next node
+    directionIndex_e                                        directionIndex;     ///< The index of the current direction we are routing
+    cellStruct_t                                            *nextNodePointer;   ///< A pointer to the next node
+
+    // Channel variables
+    std::vector<routingChannel_t>                           channels;           ///< The routing channels found in the grid
+    std::vector<channelSegment_t>                           channelSegments;    ///< Every net's connections within a channel, planned at the start of every attempt
+    std::unordered_map<unsigned long long, unsigned int>    channelPinSegments; ///< The planned connection each pin belongs to, keyed by the pin's cell index
+
+    // Grid cell properties
+    unsigned int                                            gridSizeX;          ///< The grid size in X
+    unsigned int                                            gridSizeY;          ///< The grid size in Y
+    unsigned int                                            gridSizeZ;          ///< The number of routing layers
+    std::vector<preferredDir_e>                             layerDirections;    ///< Each routing layer's preferred direction
+    bool                                                    tiledLayout;        ///< Store the cells in GRID_TILE_SIZE square tiles instead of columns, so neighbouring rows share cache lines
+    unsigned int                                            gridTilesX;         ///< The number of tiles across the grid in X (tiled layout only)
+    unsigned int                                            gridTilesY;         ///< The number of tiles across the grid in Y (tiled layout only)
+    size_t                                                  cellBlockSize;      ///< The number of cells in a column (or tile), the cells are stored block after block
+    std::vector<cellStruct_t>                               cells;              ///< These are the cells that make up the routing grid, as layer-major columns or tiles (always index them through GetCell)
+    std::vector<int>                                        cellLabels;         ///< The label plane, every cell's current expansion number (or path cost in weighted mode) at the cell's index (use GetCellLabel and SetCellLabel)
+    std::vector<cellStruct_t>                               pristineGrid;       ///< An image of the grid before any routing, restored on every attempt instead of rebuilding it
+    std::string                                             gridFilename;       ///< Keep the cells in tiles in this file instead of memory, for grids too large to fit (empty to keep them in memory)
+    unsigned int                                            residentTiles;      ///< The most tiles of the grid file kept resident between nets
+    gridFile_t                                              gridFile;           ///< The grid file, its planes replace cells, cellLabels, pristineGrid and bestGrid while it's mapped
+
+    unsigned int                                            bestNetsRouted;     ///< Keep track of the maximum number of nets we managed to route
+    std::vector<cellStruct_t>                               bestGrid;           ///< Save our best grid
+
+    // Route cache
+    bool                                                    useRouteCache;      ///< Replay cached routes for nets whose surroundings haven't changed since an earlier attempt
+    std::unordered_map<unsigned long long, routeCacheEntry_t> routeCache;       ///< Cached routes keyed by each net's pin signature
+    unsigned long long                                      currentWindowHash;  ///< Hash of the blocked cells in the current net's search window
+    unsigned int                                            routeCacheHits;     ///< A counter for the routes replayed from the cache
+
+    // Binary grids
+    std::string                                             outputFilename;     ///< Save the routed grid here once routing finishes (empty to not save it)
+    savedRouting_t                                          savedRouting;       ///< The routing loaded along with a binary grid
+
+    // Image export
+    std::string                                             imageFilename;      ///< Write an image of the grid here once routing finishes, as PNG, PPM or PostScript (empty to not write one)
+    unsigned int                                            imageCellPixels;    ///< Width and height of a cell in the image
+
+    // Window redraws
+    bool                                                    trackChangedCells;  ///< Keep track of the cells that change so the window only redraws those (only the window's grid does)
+    std::vector<posStruct_t>                                changedCells;       ///< The cells changed since the window last took them, repeats included (use MarkCellChanged)
+    bool                                                    allCellsChanged;    ///< Whether the whole grid may have changed since the window last took the changed cells (after a new attempt or restoring the best grid)
+
+    // Telemetry
+    std::string                                             telemetryFilename;  ///< Record telemetry for every net and write it here once routing finishes (empty to not record it)
+    netTelemetry_t                                          currentTelemetry;   ///< The telemetry for the net being routed
+    std::vector<netTelemetry_t>                             telemetry;          ///< The telemetry recorded for every net routed so far, across attempts
+
+} gridStruct_t;
+
+// This struct contains a domain worker's state, the domain and its halo are routed as a grid of their own
+typedef struct
+{
+    parsedInputStruct_t                     window;             ///< The window's size and its obstructions (including pins of the nets other workers route), in window coordinates
+    posStruct_t                             origin;             ///< The window's first cell in the whole grid
+    unsigned int                            left;               ///< The domain's first column in the window
+    unsigned int                            top;                ///< The domain's first row in the window
+    unsigned int                            right;              ///< One past the domain's last column in the window
+    unsigned int                            bottom;             ///< One past the domain's last row in the window
+    unsigned int                            haloPhase;          ///< The phase the domain routes into its halo in
+    gridStruct_t                            options;            ///< The routing options every phase's grid starts from
+    std::vector<unsigned int>               netIds;             ///< Every net's id in the whole grid
+    std::vector<unsigned int>               netPhases;          ///< The phase every net is routed in, 0 for the nets within the domain
+    std::vector<bool>                       netRouted;          ///< Whether every net has been routed
+    std::vector<std::vector<posStruct_t>>   netPins;            ///< Every net's pins, in window coordinates
+    std::vector<posStruct_t>                blocked;            ///< The cells routed so far by this worker and the others, in window coordinates
+} domainWorker_t;
+
+// This struct is a routing engine, the core takes care of the nets, rip-ups and retries and hands every net to an engine to route
+typedef struct Engine
+{
+    const char      *key;               ///< The engine's name on the command line
+    const char      *name;              ///< The engine's name in messages and results
+    unsigned int    maxRetries;         ///< The number of retries before giving up on a grid
+    const Engine    *fallback;          ///< The engine that gets a go at the nets this one fails (NULL to fail them)
+
+    void            (*init)(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);      ///< Called at the start of every attempt, once the nets have been shuffled (NULL if there's nothing to do)
+    void            (*beginNet)(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);  ///< Start routing the current net, going to the engine's first state
+    void            (*step)(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);      ///< Take a single step on the current net, ending with FinishNet or FailNet
+} routerEngine_t;
+
+extern const routerEngine_t leeMooreEngine;
+extern const routerEngine_t lineProbeEngine;
+extern const routerEngine_t raceEngine;
+extern const routerEngine_t channelEngine;
+
+void DrawScreen(void);
+void UpdateScreen(void);
+void TakeChangedCells(gridStruct_t *gridStruct, std::vector<posStruct_t> *changedCells, bool *allCellsChanged);
+void GetScreenCell(unsigned int x, unsigned int y, cellSnapshot_t *cellSnapshot);
+void DrawCell(cellSnapshot_t *cell, unsigned int x, unsigned int y);
+
+// Router core
+int RouterMain(int argc, char **argv, const routerEngine_t *defaultEngine);
+const routerEngine_t* FindEngine(const char *key);
+bool RouterInit(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void RouterExec(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, stepType_e stepType);
+void RouterRun(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, stepType_e stepType);
+bool RouterStep(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void BeginNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void FinishNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void FailNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void ResetNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void GetStatusMessage(gridStruct_t *gridStruct, char *strBuff);
+bool TimeBudgetExpired(gridStruct_t *gridStruct);
+bool ParseRetryPolicy(const char *name, retryPolicy_e *policy);
+void RecordFailedNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void PromoteFailedNets(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+bool CompareFailureRanks(const std::pair<unsigned int, unsigned int> &rank0, const std::pair<unsigned int, unsigned int> &rank1);
+void ReservePinAccess(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void FindWalledInNets(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+bool IsNetWalledIn(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, unsigned int net);
+bool IsReservedCell(gridStruct_t *gridStruct, cellStruct_t *cell);
+
+// Lee Moore engine
+void LeeMooreBeginNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void LeeMooreStep(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+bool ExpandBucket(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+int GetStepCost(gridStruct_t *gridStruct, cellStruct_t *cell, cellStruct_t *nextCell, unsigned int dir, unsigned int layer);
+
+// Line probe engine
+void LineProbeInit(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void LineProbeBeginNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void LineProbeStep(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+bool FindDetour(gridStruct_t *gridStruct, std::vector<cellStruct_t*> *detour);
+void SetSeekDirection(cellStruct_t *cell, gridStruct_t *gridStruct);
+void GetDirection(cellStruct_t *cell0, cellStruct_t *cell1, gridStruct_t *gridStruct);
+void GetDistanceDelta(gridStruct_t *gridStruct, cellStruct_t *cell0, cellStruct_t *cell1, unsigned int * distanceDelta);
+
+// Channel engine
+void ChannelInit(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void ChannelBeginNet(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void ChannelStep(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void FindChannels(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void PlanChannel(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, unsigned int channel, std::vector<std::pair<unsigned int, unsigned int>> *segments, std::vector<int> *occupancy);
+bool FitSegment(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, channelSegment_t *segment, unsigned int track, std::vector<int> *occupancy);
+bool LayChannelSegments(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+
+// Background routing
+void TakeGridSnapshot(gridStruct_t *gridStruct, gridSnapshot_t *snapshot);
+void PublishGridSnapshot(gridStruct_t *gridStruct);
+void StartRoutingThread(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, stepType_e stepType);
+void RoutingThread(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, stepType_e stepType);
+void StopRoutingThread(void);
+void ActOnRoutingTimer(void);
+
+// Batch routing
+bool ListInputFiles(const char *path, std::vector<std::string> *filenames);
+bool RouteBatch(std::vector<std::string> *filenames, gridStruct_t *options, unsigned int layers, unsigned int threads);
+void RouteBatchWorker(std::vector<batchJob_t> *jobs, std::vector<batchQueue_t> *queues, unsigned int worker, gridStruct_t *options, unsigned int layers);
+bool TakeBatchJob(std::vector<batchQueue_t> *queues, unsigned int worker, unsigned int *job);
+void RouteBatchJob(batchJob_t *job, gridStruct_t *options, unsigned int layers);
+
+// Domain decomposition
+bool RouteDomains(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, unsigned int domainsX, unsigned int domainsY);
+void SplitDomains(parsedInputStruct_t *parsedInputStruct, unsigned int domainsX, unsigned int domainsY, std::vector<routingDomain_t> *domains);
+int AssignDomainNet(std::vector<routingDomain_t> *domains, std::vector<posStruct_t> *netNodes, unsigned int *phase);
+bool IsInDomain(routingDomain_t *domain, posStruct_t *pos, bool halo);
+bool StartDomainWorker(std::vector<routingDomain_t> *domains, unsigned int domain);
+void GetDomainProblem(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, std::vector<routingDomain_t> *domains, std::vector<int> *netDomains, std::vector<unsigned int> *netPhases, unsigned int domain, std::vector<unsigned int> *payload);
+void DomainWorker(int socket);
+bool SetDomainProblem(domainWorker_t *worker, std::vector<unsigned int> *payload);
+void RouteDomainPhase(domainWorker_t *worker, unsigned int phase, std::vector<unsigned int> *results);
+bool TakeDomainValue(std::vector<unsigned int> *payload, size_t *cursor, unsigned int *value);
+bool TakeDomainPos(std::vector<unsigned int> *payload, size_t *cursor, posStruct_t *pos);
+void PutDomainPos(std::vector<unsigned int> *payload, posStruct_t *pos);
+bool WriteDomainMessage(int socket, domainMessage_e type, std::vector<unsigned int> *payload);
+bool ReadDomainMessage(int socket, domainMessage_e *type, std::vector<unsigned int> *payload);
+
+// Grid files
+bool MapGridFile(const char *filename, gridFile_t *gridFile, size_t numTiles, size_t tileSize);
+void UnmapGridFile(gridFile_t *gridFile);
+cellStruct_t* GetTileCells(gridFile_t *gridFile, gridPlane_e plane, size_t tile);
+void TouchTile(gridFile_t *gridFile, cellStruct_t *cell);
+void TrimWorkingSet(gridFile_t *gridFile);
+void DiscardTile(gridFile_t *gridFile, gridPlane_e plane, size_t tile);
+void CopyGridPlane(gridFile_t *gridFile, gridPlane_e fromPlane, gridPlane_e toPlane);
+size_t GetNumCellBlocks(gridStruct_t *gridStruct);
+cellStruct_t* GetCellBlock(gridStruct_t *gridStruct, size_t block, size_t *blockSize);
+void ReleaseCellBlock(gridStruct_t *gridStruct, size_t block);
+void SaveBestGrid(gridStruct_t *gridStruct);
+bool RestoreBestGrid(gridStruct_t *gridStruct);
+
+// Helpers
+cellStruct_t* GetCell(gridStruct_t *gridStruct, unsigned int x, unsigned int y, unsigned int z);
+size_t GetCellIndex(gridStruct_t *gridStruct, cellStruct_t *cell);
+void GetCellPos(gridStruct_t *gridStruct, cellStruct_t *cell, posStruct_t *pos);
+cellStruct_t* GetNeighbour(gridStruct_t *gridStruct, cellStruct_t *cell, unsigned int dir);
+void GetNeighbours(gridStruct_t *gridStruct, cellStruct_t *cell, cellStruct_t **neighbours);
+int GetCellNet(cellStruct_t *cell);
+void SetCellNet(gridStruct_t *gridStruct, cellStruct_t *cell, int net);
+void SetCellProp(gridStruct_t *gridStruct, cellStruct_t *cell, cellProp_e prop);
+void MarkCellChanged(gridStruct_t *gridStruct, cellStruct_t *cell);
+int* FindCellLabel(gridStruct_t *gridStruct, cellStruct_t *cell);
+int GetCellLabel(gridStruct_t *gridStruct, cellStruct_t *cell);
+void SetCellLabel(gridStruct_t *gridStruct, cellStruct_t *cell, int label);
+void ResetCellLabels(gridStruct_t *gridStruct);
+void ResetCellExpansion(gridStruct_t *gridStruct);
+unsigned long long HashCombine(unsigned long long hash, unsigned long long value);
+unsigned long long GetNetSignature(std::vector<posStruct_t> *netNodes);
+unsigned long long GetWindowHash(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void StoreCachedRoute(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+bool ReplayCachedRoute(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+bool FindBlockingNets(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct, std::vector<bool> *victims);
+bool RipUpBlockingNets(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+cardinalDir_e GetOppositeDirection(unsigned int dir);
+bool MapFile(const char *filename, mappedFile_t *mappedFile);
+void UnmapFile(mappedFile_t *mappedFile);
+bool ReadLineInt(const char **cursor, const char *end, int *value);
+void NextLine(const char **cursor, const char *end);
+bool ParseInputFile(const char *filename, parsedInputStruct_t *inputStruct, bool verbose);
+bool IsBinaryGridFile(const char *filename);
+bool LoadBinaryGrid(const char *filename, parsedInputStruct_t *inputStruct, gridStruct_t *gridStruct);
+bool SaveBinaryGrid(const char *filename, parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+bool WriteSection(FILE *outputFile, unsigned long long offset, const void *data, size_t size);
+bool RestoreSavedRouting(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+bool ReadLineWord(const char **cursor, const char *end, std::string *word);
+int FindNetByPin(parsedInputStruct_t *parsedInputStruct, posStruct_t *pin);
+bool ApplyRoutingDelta(const char *filename, parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void BeginNetTelemetry(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+void EndNetTelemetry(gridStruct_t *gridStruct, bool routed);
+bool WriteTelemetry(const char *filename, gridStruct_t *gridStruct);
+bool WriteGridImage(const char *filename, gridStruct_t *gridStruct, unsigned int cellPixels);
+void RenderGridImage(gridStruct_t *gridStruct, unsigned int cellPixels, std::vector<unsigned char> *pixels);
+bool WritePpm(const char *filename, unsigned int width, unsigned int height, std::vector<unsigned char> *pixels);
+bool WritePng(const char *filename, unsigned int width, unsigned int height, std::vector<unsigned char> *pixels);
+bool WritePngChunk(FILE *outputFile, const char *type, const unsigned char *data, unsigned int size);
+std::vector<unsigned int> MakeCrcTable(void);
+bool WriteGridPostScript(const char *filename, gridStruct_t *gridStruct);
+bool PopulateCellInfo(parsedInputStruct_t *parsedInputStruct, gridStruct_t *gridStruct);
+
+void ActOnNewButtonFunc(void(*drawscreen_ptr)(void));
+void ActOnButtonPress(float x, float y);
+void ActOnMouseMove(float x, float y);
+void ActOnKeyPress(char c);
+
+bool ParseInputFile(std::ifstream *inputFile, gridStruct_t *gridStruct);
+bool PopulateCellInfo(gridStruct_t *gridStruct);
\ No newline at end of file
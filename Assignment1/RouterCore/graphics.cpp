@@ -195,6 +195,8 @@
 #include <X11/Xutil.h>
 #include <X11/Xos.h>
 #include <X11/Xatom.h>
+#include <sys/select.h>
+#include <sys/time.h>
 
 /* Uncomment the line below if your X11 header files don't define XPointer */
 /* typedef char *XPointer;                                                 */
@@ -329,6 +331,8 @@ static int background_cindex;
 static int font_is_loaded[MAX_FONT_SIZE + 1];  /* 1: loaded, 0: not  */
 static void load_font(int pointsize);
 static bool get_keypress_input = false, get_mouse_move_input = false;
+static void (*timer_callback)(void) = NULL;   /* Called every timer_period_ms from event_loop */
+static int timer_period_ms = 0;
 
 
 /*********************************************
@@ -372,6 +376,7 @@ static GC gc, gcxor, gc_menus, current_gc;
 static XFontStruct *font_info[MAX_FONT_SIZE + 1]; /* Data for each size */
 static Window toplevel, menu, textarea;  /* various windows */
 static Colormap private_cmap; /* "None" unless a private cmap was allocated. */
+static struct timeval timer_due;  /* When timer_callback should next be called */
 
 /* Color indices passed back from X Windows. */
 static int colors[NUM_COLOR];
@@ -389,6 +394,7 @@ static int which_button(Window win);
 
 static void turn_on_off(int pressed);
 static void drawmenu(void);
+static bool x11_wait_for_timer(void);
 
 #endif /* X11 Declarations */
 
@@ -1348,6 +1354,11 @@ event_loop(void(*act_on_mousebutton)(float x, float y),
     turn_on_off(ON);
     while(1)
     {
+        if(x11_wait_for_timer())
+        {
+            timer_callback();
+            continue;
+        }
         XNextEvent(display, &report);
         switch(report.type)
         {
@@ -2859,6 +2870,21 @@ void set_keypress_input(bool enable)
 }
 
 
+void set_timer_callback(void(*act_on_timer) (void), int period_ms)
+{
+    timer_callback = act_on_timer;
+    timer_period_ms = period_ms;
+#ifdef WIN32
+    if(act_on_timer != NULL)
+        SetTimer(hMainWnd, 1, period_ms, NULL);
+    else
+        KillTimer(hMainWnd, 1);
+#else  // X11
+    gettimeofday(&timer_due, NULL);
+#endif
+}
+
+
 void enable_or_disable_button(int ibutton, bool enabled)
 {
 
@@ -3141,6 +3167,50 @@ static void turn_on_off(int pressed)
 }
 
 
+static bool x11_wait_for_timer(void)
+{
+    /* Waits until either an event arrives or the timer is due.  Returns
+     * true if the timer is due (and sets when it's next due), false if
+     * there's an event to handle or no timer at all.
+     */
+    struct timeval now, timeout;
+    fd_set fds;
+    long remaining_ms;
+    int fd;
+
+    if(timer_callback == NULL)
+        return false;
+
+    gettimeofday(&now, NULL);
+    remaining_ms = (timer_due.tv_sec - now.tv_sec) * 1000 + (timer_due.tv_usec - now.tv_usec) / 1000;
+
+    /* XPending also flushes anything drawn since the last event */
+    if(remaining_ms > 0 && XPending(display) == 0)
+    {
+        fd = ConnectionNumber(display);
+        FD_ZERO(&fds);
+        FD_SET(fd, &fds);
+        timeout.tv_sec = remaining_ms / 1000;
+        timeout.tv_usec = (remaining_ms % 1000) * 1000;
+        if(select(fd + 1, &fds, NULL, NULL, &timeout) > 0)
+            return false;
+        gettimeofday(&now, NULL);
+        remaining_ms = 0;
+    }
+    if(remaining_ms > 0)
+        return false;
+
+    timer_due.tv_sec = now.tv_sec + timer_period_ms / 1000;
+    timer_due.tv_usec = now.tv_usec + (timer_period_ms % 1000) * 1000;
+    if(timer_due.tv_usec >= 1000000)
+    {
+        timer_due.tv_sec++;
+        timer_due.tv_usec -= 1000000;
+    }
+    return true;
+}
+
+
 static void drawmenu(void)
 {
     int i;
@@ -3221,6 +3291,11 @@ MainWND(HWND hwnd, UINT message, WPARAM wParam, LPARAM lParam)
             if(get_keypress_input)
                 keypress_ptr((char)wParam);
             return 0;
+
+        case WM_TIMER:
+            if(timer_callback != NULL)
+                timer_callback();
+            return 0;
     }
 
     return DefWindowProc(hwnd, message, wParam, lParam);
@@ -3966,6 +4041,7 @@ void event_loop(void(*act_on_mousebutton) (float x, float y),
 {}
 
 void init_graphics(const char *window_name, int cindex) {}
+void set_timer_callback(void(*act_on_timer) (void), int period_ms) {}
 void close_graphics(void) {}
 void update_message(const char *msg) {}
 void draw_message(void) {}
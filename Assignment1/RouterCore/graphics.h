@@ -210,6 +210,12 @@ void flushinput (void);
 enum e_draw_mode {DRAW_NORMAL = 0, DRAW_XOR};
 void set_draw_mode (enum e_draw_mode draw_mode);
 
+/* Calls act_on_timer about every period_ms milliseconds from inside
+ * event_loop, e.g. to redraw results computed by another thread.
+ * Pass NULL to stop calling it.  Call it after init_graphics.
+ */
+void set_timer_callback (void (*act_on_timer) (void), int period_ms);
+
 /* Change the text on a button.
  */
 void change_button_text(const char *button_text, const char *new_button_text);